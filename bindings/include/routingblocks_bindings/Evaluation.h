@@ -26,11 +26,38 @@
 #include <pybind11/smart_holder.h>
 #include <routingblocks/evaluation.h>
 
+#include <optional>
+
 PYBIND11_SMART_HOLDER_TYPE_CASTERS(routingblocks::Evaluation)
 
 namespace routingblocks::bindings {
 
     void bind_evaluation(pybind11::module& m);
+
+    /**
+     * Throws if the evaluation is implemented in Python and number_of_threads > 1. Labels of such
+     * evaluations are Python objects, which must not be created, copied, or destroyed without
+     * holding the GIL.
+     */
+    void check_evaluation_supports_threads(const routingblocks::Evaluation& evaluation,
+                                           size_t number_of_threads);
+
+    /**
+     * Releases the GIL for the lifetime of the object if native code is about to run on more than
+     * one thread. Checks the evaluation beforehand, see check_evaluation_supports_threads.
+     */
+    class threaded_gil_release {
+        std::optional<pybind11::gil_scoped_release> _release;
+
+      public:
+        threaded_gil_release(const routingblocks::Evaluation& evaluation,
+                             size_t number_of_threads) {
+            check_evaluation_supports_threads(evaluation, number_of_threads);
+            if (number_of_threads > 1) {
+                _release.emplace();
+            }
+        }
+    };
 }
 
 #endif  // routingblocks_EVALUATION_H
@@ -21,6 +21,11 @@
 #ifndef BINDINGS_HELPERS_HPP
 #define BINDINGS_HELPERS_HPP
 
+#include <routingblocks/BatchFRVCP.h>
+#include <routingblocks/TypedRoute.h>
+#include <routingblocks/relatedness_matrix.h>
+#include <routingblocks/operators/SwapOperator.h>
+
 #include <sstream>
 #include <string>
 
@@ -89,6 +94,133 @@ namespace bindings::helpers {
             .def("create_backward_label", &T::create_backward_label);
     }
 
+    template <class T> auto bind_typed_route(pybind11::module_& m, const char* name) {
+        using route_t = routingblocks::TypedRoute<T>;
+        return pybind11::class_<route_t>(m, name)
+            .def(pybind11::init<std::shared_ptr<T>, const routingblocks::Instance&>())
+            .def(pybind11::init<>([](std::shared_ptr<T> evaluation,
+                                     const routingblocks::Instance& instance,
+                                     const std::vector<routingblocks::VertexID>& vertex_ids) {
+                return route_t(std::move(evaluation), instance, vertex_ids.begin(),
+                               vertex_ids.end());
+            }))
+            .def(pybind11::init<std::shared_ptr<T>, const routingblocks::Instance&,
+                                const routingblocks::Route&>())
+            .def_property_readonly("cost", &route_t::cost)
+            .def_property_readonly("cost_components", &route_t::cost_components)
+            .def_property_readonly("feasible", &route_t::feasible)
+            .def_property_readonly("empty", &route_t::empty)
+            .def_property_readonly("vertex_ids",
+                                   [](const route_t& route) {
+                                       auto ids = route.vertex_ids();
+                                       return std::vector<routingblocks::VertexID>(ids.begin(),
+                                                                                   ids.end());
+                                   })
+            .def("__len__", &route_t::size)
+            .def("to_route", &route_t::to_route)
+            .def("remove_segment", &route_t::remove_segment)
+            .def("insert_segment_after",
+                 [](route_t& route, size_t position,
+                    const std::vector<routingblocks::VertexID>& vertex_ids) {
+                     route.insert_segment_after(position, vertex_ids.begin(), vertex_ids.end());
+                 })
+            .def("evaluate_insertion", &route_t::evaluate_insertion)
+            .def("evaluate_removal", &route_t::evaluate_removal);
+    }
+
+    template <class T, size_t OriginSegmentSize, size_t TargetSegmentSize>
+    void bind_typed_swap_operator(pybind11::module_& m, const std::string& prefix) {
+        using operator_t
+            = routingblocks::SwapOperator<OriginSegmentSize, TargetSegmentSize, T>;
+
+        std::stringstream name;
+        name << prefix << "SwapOperator"
+             << "_" << OriginSegmentSize << "_" << TargetSegmentSize;
+        auto name_str = name.str();
+
+        pybind11::class_<operator_t, routingblocks::Operator>(
+            m, name_str.data(),
+            "Swap operator that evaluates moves without virtual dispatch. Requires the "
+            "solution to use the matching evaluation.")
+            .def(pybind11::init<const routingblocks::Instance&,
+                                const routingblocks::utility::arc_set*>(),
+                 pybind11::keep_alive<1, 2>(), pybind11::keep_alive<1, 3>())
+            .def("prepare_search", &operator_t::prepare_search)
+            .def("find_next_improving_move", &operator_t::find_next_improving_move)
+            .def("finalize_search", &operator_t::finalize_search)
+            .def("create_move", &operator_t::create_move,
+                 "Create a move that represents a given generator arc.");
+    }
+
+    template <class VertexData, class ArcData>
+    void bind_relatedness_matrix_builders(pybind11::module_& m, const std::string& prefix) {
+        using routingblocks::utility::build_distance_relatedness_matrix;
+        using routingblocks::utility::build_shaw_relatedness_matrix;
+        using routingblocks::utility::build_spatio_temporal_relatedness_matrix;
+        m.def(("build_" + prefix + "_distance_relatedness_matrix").c_str(),
+              &build_distance_relatedness_matrix<VertexData, ArcData>, pybind11::arg("instance"),
+              pybind11::arg("number_of_neighbors"),
+              pybind11::call_guard<pybind11::gil_scoped_release>());
+        m.def(("build_" + prefix + "_spatio_temporal_relatedness_matrix").c_str(),
+              &build_spatio_temporal_relatedness_matrix<VertexData, ArcData>,
+              pybind11::arg("instance"), pybind11::arg("slack_weight"),
+              pybind11::arg("tw_shift_weight"), pybind11::arg("number_of_neighbors"),
+              pybind11::call_guard<pybind11::gil_scoped_release>());
+        m.def(("build_" + prefix + "_shaw_relatedness_matrix").c_str(),
+              &build_shaw_relatedness_matrix<VertexData, ArcData>, pybind11::arg("instance"),
+              pybind11::arg("distance_weight"), pybind11::arg("demand_weight"),
+              pybind11::arg("time_weight"), pybind11::arg("number_of_neighbors"),
+              pybind11::call_guard<pybind11::gil_scoped_release>());
+    }
+
+    template <class Label, class Binding> auto bind_frvcp(Binding& optimizer) {
+        using optimizer_t = routingblocks::FRVCP<Label>;
+        return optimizer
+            .def("optimize", &optimizer_t::optimize,
+                 "Solve the detour embedding problem for the specified route.")
+            .def_property_readonly("cache_capacity", &optimizer_t::cache_capacity)
+            .def_property_readonly("cache_hits", &optimizer_t::cache_hits)
+            .def_property_readonly("cache_misses", &optimizer_t::cache_misses)
+            .def_property_readonly("number_of_labels", &optimizer_t::number_of_labels)
+            .def("clear_cache", &optimizer_t::clear_cache, "Forget all memorized results.");
+    }
+
+    template <class Label, class Binding> auto bind_batch_frvcp(Binding& optimizer) {
+        using optimizer_t = routingblocks::BatchFRVCP<Label>;
+        return optimizer.def_property_readonly("number_of_threads", &optimizer_t::number_of_threads)
+            .def(
+                "optimize",
+                [](optimizer_t& optimizer,
+                   const std::vector<std::vector<routingblocks::VertexID>>& routes) {
+                    pybind11::gil_scoped_release release;
+                    return optimizer.optimize(routes);
+                },
+                "Solve the detour embedding problem for each of the specified routes.")
+            .def(
+                "optimize",
+                [](optimizer_t& optimizer, const routingblocks::Solution& solution) {
+                    pybind11::gil_scoped_release release;
+                    return optimizer.optimize(solution);
+                },
+                "Solve the detour embedding problem for each route of the specified solution.");
+    }
+
+    template <class T> void bind_typed_swap_operators(pybind11::module_& m,
+                                                      const std::string& prefix) {
+        bind_typed_swap_operator<T, 0, 1>(m, prefix);
+        bind_typed_swap_operator<T, 0, 2>(m, prefix);
+        bind_typed_swap_operator<T, 0, 3>(m, prefix);
+        bind_typed_swap_operator<T, 1, 1>(m, prefix);
+        bind_typed_swap_operator<T, 1, 2>(m, prefix);
+        bind_typed_swap_operator<T, 1, 3>(m, prefix);
+        bind_typed_swap_operator<T, 2, 1>(m, prefix);
+        bind_typed_swap_operator<T, 2, 2>(m, prefix);
+        bind_typed_swap_operator<T, 2, 3>(m, prefix);
+        bind_typed_swap_operator<T, 3, 1>(m, prefix);
+        bind_typed_swap_operator<T, 3, 2>(m, prefix);
+        bind_typed_swap_operator<T, 3, 3>(m, prefix);
+    }
+
 }  // namespace bindings::helpers
 
 #endif
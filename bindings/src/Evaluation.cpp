@@ -22,6 +22,7 @@
 #include <routingblocks_bindings/Evaluation.h>
 
 #include <algorithm>
+#include <stdexcept>
 #include <routingblocks_bindings/binding_helpers.hpp>
 
 namespace routingblocks::bindings {
@@ -90,26 +91,28 @@ namespace routingblocks::bindings {
                                                      const Vertex& pred_vertex,
                                                      const Vertex& vertex,
                                                      const Arc& arc) const final {
-            return Evaluation::label_holder_t(std::make_shared<py_type>(
-                py_propagate_forward(pred_label.get<py_type>(), pred_vertex, vertex, arc)));
+            return Evaluation::label_holder_t(
+                std::in_place_type<py_type>,
+                py_propagate_forward(pred_label.get<py_type>(), pred_vertex, vertex, arc));
         }
 
         Evaluation::label_holder_t propagate_backward(const Evaluation::label_holder_t& succ_label,
                                                       const Vertex& succ_vertex,
                                                       const Vertex& vertex,
                                                       const Arc& arc) const final {
-            return Evaluation::label_holder_t(std::make_shared<py_type>(
-                py_propagate_backward(succ_label.get<py_type>(), succ_vertex, vertex, arc)));
+            return Evaluation::label_holder_t(
+                std::in_place_type<py_type>,
+                py_propagate_backward(succ_label.get<py_type>(), succ_vertex, vertex, arc));
         }
 
         Evaluation::label_holder_t create_forward_label(const Vertex& vertex) final {
             return Evaluation::label_holder_t(
-                std::make_shared<py_type>(py_create_forward_label(vertex)));
+                std::in_place_type<py_type>, py_create_forward_label(vertex));
         }
 
         Evaluation::label_holder_t create_backward_label(const Vertex& vertex) final {
             return Evaluation::label_holder_t(
-                std::make_shared<py_type>(py_create_backward_label(vertex)));
+                std::in_place_type<py_type>, py_create_backward_label(vertex));
         }
 
         std::vector<resource_t> get_cost_components(
@@ -162,27 +165,29 @@ namespace routingblocks::bindings {
         ConcatenationBasedEvaluation::label_holder_t propagate_forward(
             const ConcatenationBasedEvaluation::label_holder_t& pred_label,
             const Vertex& pred_vertex, const Vertex& vertex, const Arc& arc) const final {
-            return ConcatenationBasedEvaluation::label_holder_t(std::make_shared<py_type>(
-                py_propagate_forward(pred_label.get<py_type>(), pred_vertex, vertex, arc)));
+            return ConcatenationBasedEvaluation::label_holder_t(
+                std::in_place_type<py_type>,
+                py_propagate_forward(pred_label.get<py_type>(), pred_vertex, vertex, arc));
         }
 
         ConcatenationBasedEvaluation::label_holder_t propagate_backward(
             const ConcatenationBasedEvaluation::label_holder_t& succ_label,
             const Vertex& succ_vertex, const Vertex& vertex, const Arc& arc) const final {
-            return ConcatenationBasedEvaluation::label_holder_t(std::make_shared<py_type>(
-                py_propagate_backward(succ_label.get<py_type>(), succ_vertex, vertex, arc)));
+            return ConcatenationBasedEvaluation::label_holder_t(
+                std::in_place_type<py_type>,
+                py_propagate_backward(succ_label.get<py_type>(), succ_vertex, vertex, arc));
         }
 
         ConcatenationBasedEvaluation::label_holder_t create_forward_label(
             const Vertex& vertex) final {
             return ConcatenationBasedEvaluation::label_holder_t(
-                std::make_shared<py_type>(py_create_forward_label(vertex)));
+                std::in_place_type<py_type>, py_create_forward_label(vertex));
         }
 
         ConcatenationBasedEvaluation::label_holder_t create_backward_label(
             const Vertex& vertex) final {
             return ConcatenationBasedEvaluation::label_holder_t(
-                std::make_shared<py_type>(py_create_backward_label(vertex)));
+                std::in_place_type<py_type>, py_create_backward_label(vertex));
         }
 
         std::vector<resource_t> get_cost_components(
@@ -324,6 +329,16 @@ namespace routingblocks::bindings {
             .def("create_backward_label", &PyEvaluation::py_create_backward_label);
     }
 
+    void check_evaluation_supports_threads(const routingblocks::Evaluation& evaluation,
+                                           size_t number_of_threads) {
+        if (number_of_threads > 1
+            && (dynamic_cast<const PyEvaluation*>(&evaluation) != nullptr
+                || dynamic_cast<const PyConcatenationBasedEvaluation*>(&evaluation) != nullptr)) {
+            throw std::runtime_error(
+                "Evaluations implemented in Python cannot be used with more than one thread.");
+        }
+    }
+
     void bind_evaluation(pybind11::module& m) {
         auto evaluation_interface = bind_evaluation_interface(m);
         bind_py_evaluation(m, evaluation_interface);
@@ -54,6 +54,23 @@ namespace routingblocks::bindings {
                 "classes defined in Python.");
     }
 
+    template <class ArcData>
+    routingblocks::Instance dense_instance_constructor(
+        std::vector<routingblocks::Vertex> vertices,
+        const std::vector<std::vector<ArcData>>& arc_data, int fleet_size) {
+        std::vector<ArcData> flat_arc_data;
+        flat_arc_data.reserve(arc_data.size() * arc_data.size());
+        for (const auto& row : arc_data) {
+            if (row.size() != arc_data.size()) {
+                throw std::runtime_error("Arc matrix is not square");
+            }
+            flat_arc_data.insert(flat_arc_data.end(), row.begin(), row.end());
+        }
+        return routingblocks::Instance(
+            std::move(vertices), routingblocks::make_arc_matrix(std::move(flat_arc_data)),
+            fleet_size);
+    }
+
     void bind_routingblocks_instance(pybind11::module& m) {
         bind_vertex<pybind11::object>(m, "Vertex");
         bind_arc<pybind11::object>(m, "Arc");
@@ -66,6 +83,16 @@ namespace routingblocks::bindings {
             .def(pybind11::init<routingblocks::Vertex, std::vector<routingblocks::Vertex>,
                                 std::vector<routingblocks::Vertex>,
                                 std::vector<std::vector<routingblocks::Arc>>, int>())
+            .def(pybind11::init(&dense_instance_constructor<routingblocks::ADPTWArcData>),
+                 pybind11::arg("vertices"), pybind11::arg("arc_data"),
+                 pybind11::arg("fleet_size") = 0,
+                 "Creates an instance from a matrix of ADPTWArcData. Stores the arc data in a "
+                 "single contiguous block.")
+            .def(pybind11::init(&dense_instance_constructor<routingblocks::NIFTWArcData>),
+                 pybind11::arg("vertices"), pybind11::arg("arc_data"),
+                 pybind11::arg("fleet_size") = 0,
+                 "Creates an instance from a matrix of NIFTWArcData. Stores the arc data in a "
+                 "single contiguous block.")
             .def_property_readonly("fleet_size", &routingblocks::Instance::FleetSize,
                                    "The number of "
                                    "vehicles available.")
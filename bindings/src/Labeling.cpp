@@ -114,10 +114,12 @@ namespace routingblocks::bindings {
                   .def(pybind11::init<>());
         bind_propagator<PyPropagator>(propagator_interface);
 
-        pybind11::class_<FRVCP<PyPropagator::value_type>>(m, "FacilityPlacementOptimizer")
-            .def(pybind11::init<const Instance&, std::shared_ptr<PyPropagator>>())
-            .def("optimize", &FRVCP<PyPropagator::value_type>::optimize,
-                 "Solves the detour embedding problem for the specified route.");
+        auto optimizer = pybind11::class_<FRVCP<PyPropagator::value_type>>(
+            m, "FacilityPlacementOptimizer");
+        optimizer.def(pybind11::init<const Instance&, std::shared_ptr<PyPropagator>, size_t>(),
+                      pybind11::arg("instance"), pybind11::arg("propagator"),
+                      pybind11::arg("cache_capacity") = 0);
+        ::bindings::helpers::bind_frvcp<PyPropagator::value_type>(optimizer);
     }
 
 }  // namespace routingblocks::bindings
\ No newline at end of file
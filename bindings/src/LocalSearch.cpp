@@ -21,6 +21,7 @@
 #include <pybind11/stl.h>
 #include <routingblocks/LocalSearch.h>
 #include <routingblocks/utility/random.h>
+#include <routingblocks_bindings/Evaluation.h>
 #include <routingblocks_bindings/LocalSearch.h>
 
 namespace routingblocks::bindings {
@@ -66,13 +67,33 @@ namespace routingblocks::bindings {
 
     void bind_local_search(pybind11::module& m) {
         pybind11::class_<routingblocks::LocalSearch>(m, "LocalSearch")
-            .def(pybind11::init<const routingblocks::Instance&, std::shared_ptr<Evaluation>,
-                                std::shared_ptr<Evaluation>, PivotingRule*>(),
-                 pybind11::keep_alive<1, 2>(), pybind11::keep_alive<1, 5>())
+            .def(pybind11::init([](const routingblocks::Instance& instance,
+                                   std::shared_ptr<Evaluation> evaluation,
+                                   std::shared_ptr<Evaluation> exact_evaluation,
+                                   PivotingRule* pivoting_rule, size_t number_of_threads) {
+                     check_evaluation_supports_threads(*evaluation, number_of_threads);
+                     if (exact_evaluation) {
+                         check_evaluation_supports_threads(*exact_evaluation, number_of_threads);
+                     }
+                     return std::make_unique<LocalSearch>(instance, std::move(evaluation),
+                                                          std::move(exact_evaluation),
+                                                          pivoting_rule, number_of_threads);
+                 }),
+                 pybind11::arg("instance"), pybind11::arg("evaluation"),
+                 pybind11::arg("exact_evaluation"), pybind11::arg("pivoting_rule"),
+                 pybind11::arg("number_of_threads") = 1, pybind11::keep_alive<1, 2>(),
+                 pybind11::keep_alive<1, 5>())
+            .def_property_readonly("number_of_threads", &LocalSearch::number_of_threads)
             .def(
                 "optimize",
                 [](LocalSearch& ls, Solution& sol, std::vector<Operator*> operators) -> void {
-                    ls.run(sol, operators.begin(), operators.end());
+                    if (ls.number_of_threads() > 1) {
+                        // Evaluations were checked on construction.
+                        pybind11::gil_scoped_release release;
+                        ls.run(sol, operators.begin(), operators.end());
+                    } else {
+                        ls.run(sol, operators.begin(), operators.end());
+                    }
                 },
                 "Optimizes the passed solution inplace.");
     }
@@ -43,6 +43,9 @@ namespace routingblocks::bindings {
         void finalize_search() override {
             PYBIND11_OVERRIDE_PURE(void, routingblocks::Operator, finalize_search);
         }
+        void invalidate_cache() override {
+            PYBIND11_OVERRIDE(void, routingblocks::Operator, invalidate_cache);
+        }
     };
 
     class PyMove : public routingblocks::Move {
@@ -69,7 +72,9 @@ namespace routingblocks::bindings {
             .def("find_next_improving_move", &routingblocks::Operator::find_next_improving_move,
                  "Find the next improving move.")
             .def("finalize_search", &routingblocks::Operator::finalize_search,
-                 "Finalize the search.");
+                 "Finalize the search.")
+            .def("invalidate_cache", &routingblocks::Operator::invalidate_cache,
+                 "Discard information cached across searches.");
     }
 
     auto bind_move_interface(pybind11::module_& m) {
@@ -49,8 +49,8 @@ namespace routingblocks::bindings {
                                    pybind11::object bwd_label) {
                      return routingblocks::Node{
                          vertex,
-                         {std::make_shared<pybind11::object>(std::move(fwd_label))},
-                         {std::make_shared<pybind11::object>(std::move(bwd_label))}};
+                         routingblocks::detail::make_label<pybind11::object>(std::move(fwd_label)),
+                         routingblocks::detail::make_label<pybind11::object>(std::move(bwd_label))};
                  }),
                  "Creates a node tracking the given vertex and initializes forward and backward"
                  "labels.")
@@ -21,11 +21,15 @@
 #include <routingblocks/Instance.h>
 #include <routingblocks/lns_operators.h>
 #include <routingblocks/operators.h>
+#include <routingblocks/parallel_adaptive_large_neighborhood.h>
+#include <routingblocks_bindings/Evaluation.h>
 #include <routingblocks_bindings/large_neighborhood.h>
 
 #include <routingblocks/adaptive_large_neighborhood.hpp>
 #include <routingblocks_bindings/binding_helpers.hpp>
 
+#include <unordered_map>
+
 /*
  * Couple the lifetime of objects created in python to the shared_ptr lifetime in c++.
  */
@@ -118,6 +122,201 @@ namespace routingblocks::bindings {
                  "Return true: random insertion is always possible.");
     }
 
+    void bind_move_selectors(pybind11::module_& m) {
+        using namespace routingblocks::lns::operators;
+        pybind11::class_<MoveSelector>(m, "_MoveSelector")
+            .def("select", &MoveSelector::select,
+                 "Returns the index of the selected move in a sequence of the given length.",
+                 pybind11::arg("number_of_moves"));
+        pybind11::class_<FirstMoveSelector, MoveSelector>(m, "_FirstMoveSelector")
+            .def(pybind11::init<>());
+        pybind11::class_<LastMoveSelector, MoveSelector>(m, "_LastMoveSelector")
+            .def(pybind11::init<>());
+        pybind11::class_<NthMoveSelector, MoveSelector>(m, "_NthMoveSelector")
+            .def(pybind11::init<size_t>(), pybind11::arg("n"));
+        pybind11::class_<BlinkMoveSelector, MoveSelector>(m, "_BlinkMoveSelector")
+            .def(pybind11::init<double, routingblocks::utility::random&>(),
+                 pybind11::arg("blink_probability"), pybind11::arg("random"));
+        pybind11::class_<RandomMoveSelector, MoveSelector>(m, "_RandomMoveSelector")
+            .def(pybind11::init<routingblocks::utility::random&>(), pybind11::arg("random"));
+    }
+
+    void bind_cluster_selectors(pybind11::module_& m) {
+        using namespace routingblocks::lns::operators;
+        pybind11::class_<SeedSelector>(m, "_SeedSelector");
+        pybind11::class_<StationSeedSelector, SeedSelector>(m, "_StationSeedSelector")
+            .def(pybind11::init([](const std::vector<const routingblocks::Vertex*>& stations,
+                                   routingblocks::utility::random& random) {
+                     std::vector<routingblocks::VertexID> station_ids;
+                     station_ids.reserve(stations.size());
+                     for (const auto* station : stations) {
+                         station_ids.push_back(station->id);
+                     }
+                     return StationSeedSelector(std::move(station_ids), random);
+                 }),
+                 pybind11::arg("stations"), pybind11::arg("random"));
+        pybind11::class_<ClusterMemberSelector>(m, "_ClusterMemberSelector");
+        pybind11::class_<DistanceBasedClusterMemberSelector, ClusterMemberSelector>(
+            m, "_DistanceBasedClusterMemberSelector")
+            .def(pybind11::init([](const std::vector<const routingblocks::Vertex*>& vertices,
+                                   const pybind11::function& get_distance,
+                                   resource_t min_radius_factor, resource_t max_radius_factor,
+                                   routingblocks::utility::random& random) {
+                     std::unordered_map<routingblocks::VertexID, const routingblocks::Vertex*>
+                         vertices_by_id;
+                     std::vector<routingblocks::VertexID> vertex_ids;
+                     for (const auto* vertex : vertices) {
+                         vertices_by_id[vertex->id] = vertex;
+                         vertex_ids.push_back(vertex->id);
+                     }
+                     return DistanceBasedClusterMemberSelector(
+                         vertex_ids,
+                         [&](routingblocks::VertexID i, routingblocks::VertexID j) {
+                             return get_distance(vertices_by_id[i], vertices_by_id[j])
+                                 .cast<resource_t>();
+                         },
+                         min_radius_factor, max_radius_factor, random);
+                 }),
+                 pybind11::arg("vertices"), pybind11::arg("get_distance"),
+                 pybind11::arg("min_radius_factor"), pybind11::arg("max_radius_factor"),
+                 pybind11::arg("random"));
+    }
+
+    void bind_native_destroy_operators(pybind11::module_& m, auto& interface) {
+        using namespace routingblocks::lns::operators;
+        pybind11::class_<RelatedRemoval>(m, "_RelatedRemovalOperator", interface)
+            .def(pybind11::init<const routingblocks::utility::relatedness_matrix&,
+                                const MoveSelector&, const MoveSelector&, const MoveSelector&,
+                                size_t>(),
+                 pybind11::arg("relatedness_matrix"), pybind11::arg("move_selector"),
+                 pybind11::arg("seed_selector"), pybind11::arg("initial_seed_selector"),
+                 pybind11::arg("cluster_size") = 1, pybind11::keep_alive<1, 2>())
+            .def("apply", &RelatedRemoval::apply, "Removes related vertices from the solution.")
+            .def("name", &RelatedRemoval::name)
+            .def("can_apply_to", &RelatedRemoval::can_apply_to,
+                 "Returns true if the solution has at least one route.");
+        pybind11::class_<WorstRemoval>(m, "_WorstRemovalOperator", interface)
+            .def(pybind11::init<const routingblocks::Instance&, const MoveSelector&>(),
+                 pybind11::arg("instance"), pybind11::arg("move_selector"),
+                 pybind11::keep_alive<1, 2>())
+            .def("apply", &WorstRemoval::apply,
+                 "Removes vertices one at a time according to the cost of their removal.")
+            .def("name", &WorstRemoval::name)
+            .def("can_apply_to", &WorstRemoval::can_apply_to,
+                 "Returns true if the solution has at least one route.");
+        pybind11::class_<ClusterRemoval>(m, "_ClusterRemovalOperator", interface)
+            .def(pybind11::init<const SeedSelector&, const ClusterMemberSelector&>(),
+                 pybind11::arg("seed_selector"), pybind11::arg("cluster_member_selector"))
+            .def("apply", &ClusterRemoval::apply, "Removes clusters of vertices from the solution.")
+            .def("name", &ClusterRemoval::name)
+            .def("can_apply_to", &ClusterRemoval::can_apply_to,
+                 "Returns true if the solution has at least one route.");
+        pybind11::class_<StationVicinityRemoval>(m, "_StationVicinityRemovalOperator", interface)
+            .def(pybind11::init([](const routingblocks::Instance& instance,
+                                   const pybind11::function& get_distance,
+                                   resource_t min_radius_factor, resource_t max_radius_factor,
+                                   routingblocks::utility::random& random) {
+                     return StationVicinityRemoval(
+                         instance,
+                         [&](routingblocks::VertexID i, routingblocks::VertexID j) {
+                             return get_distance(&instance.getVertex(i), &instance.getVertex(j))
+                                 .cast<resource_t>();
+                         },
+                         min_radius_factor, max_radius_factor, random);
+                 }),
+                 pybind11::arg("instance"), pybind11::arg("get_distance"),
+                 pybind11::arg("min_radius_factor"), pybind11::arg("max_radius_factor"),
+                 pybind11::arg("random"))
+            .def("apply", &StationVicinityRemoval::apply,
+                 "Removes stations and the vertices in their vicinity from the solution.")
+            .def("name", &StationVicinityRemoval::name)
+            .def("can_apply_to", &StationVicinityRemoval::can_apply_to,
+                 "Returns true if the solution visits at least one station.");
+    }
+
+    template <class Operator> auto bind_threaded_repair_apply() {
+        return [](Operator& repair_operator, Evaluation& evaluation, Solution& sol,
+                  const std::vector<routingblocks::VertexID>& missing_vertices) {
+            threaded_gil_release release(evaluation, repair_operator.number_of_threads());
+            repair_operator.apply(evaluation, sol, missing_vertices);
+        };
+    }
+
+    void bind_native_repair_operators(pybind11::module_& m, auto& interface) {
+        using namespace routingblocks::lns::operators;
+        pybind11::class_<BestInsertion>(m, "_BestInsertionOperator", interface)
+            .def(pybind11::init<const routingblocks::Instance&, const MoveSelector&, size_t>(),
+                 pybind11::arg("instance"), pybind11::arg("move_selector"),
+                 pybind11::arg("number_of_threads") = 1, pybind11::keep_alive<1, 2>())
+            .def("apply", bind_threaded_repair_apply<BestInsertion>(),
+                 "Inserts the passed vertices in order at the positions picked by the move "
+                 "selector.")
+            .def("name", &BestInsertion::name)
+            .def("can_apply_to", &BestInsertion::can_apply_to,
+                 "Return true: best insertion is always possible.")
+            .def_property_readonly("number_of_threads", &BestInsertion::number_of_threads);
+        pybind11::class_<RegretInsertion>(m, "_RegretInsertionOperator", interface)
+            .def(pybind11::init<const routingblocks::Instance&, size_t, const MoveSelector&,
+                                size_t>(),
+                 pybind11::arg("instance"), pybind11::arg("k") = 2,
+                 pybind11::arg("vertex_selector") = FirstMoveSelector(),
+                 pybind11::arg("number_of_threads") = 1, pybind11::keep_alive<1, 2>())
+            .def("apply", bind_threaded_repair_apply<RegretInsertion>(),
+                 "Inserts the passed vertices in the order picked by the vertex selector from "
+                 "the vertices ranked by regret.")
+            .def("name", &RegretInsertion::name)
+            .def("can_apply_to", &RegretInsertion::can_apply_to,
+                 "Return true: regret insertion is always possible.")
+            .def_property_readonly("number_of_threads", &RegretInsertion::number_of_threads);
+    }
+
+    void bind_parallel_large_neighborhood(pybind11::module_& m) {
+        using parameters_t = routingblocks::parallel_alns_parameters;
+        using lns_t = routingblocks::parallel_adaptive_large_neighborhood;
+        pybind11::class_<parameters_t>(m, "ParallelALNSParameters")
+            .def(pybind11::init<>())
+            .def_readwrite("number_of_workers", &parameters_t::number_of_workers)
+            .def_readwrite("number_of_iterations", &parameters_t::number_of_iterations)
+            .def_readwrite("min_removal_factor", &parameters_t::min_removal_factor)
+            .def_readwrite("max_removal_factor", &parameters_t::max_removal_factor)
+            .def_readwrite("period_length", &parameters_t::period_length)
+            .def_readwrite("smoothing_factor", &parameters_t::smoothing_factor)
+            .def_readwrite("new_best_score", &parameters_t::new_best_score)
+            .def_readwrite("improvement_score", &parameters_t::improvement_score)
+            .def_readwrite("acceptance_score", &parameters_t::acceptance_score)
+            .def_readwrite("acceptance_threshold", &parameters_t::acceptance_threshold);
+        pybind11::class_<lns_t>(m, "ParallelAdaptiveLargeNeighborhood")
+            .def(pybind11::init<routingblocks::utility::random, parameters_t>(),
+                 pybind11::arg("randgen"), pybind11::arg("parameters"))
+            .def(
+                "add_destroy_operator",
+                [](lns_t& lns, std::shared_ptr<routingblocks::destroy_operator> destroy_operator) {
+                    lns.add_operator(std::move(destroy_operator));
+                },
+                "Adds the passed destroy operator to the large neighborhood.")
+            .def(
+                "add_repair_operator",
+                [](lns_t& lns, std::shared_ptr<routingblocks::repair_operator> repair_operator) {
+                    lns.add_operator(std::move(repair_operator));
+                },
+                "Adds the passed repair operator to the large neighborhood.")
+            .def(
+                "optimize",
+                [](lns_t& lns, Evaluation& evaluation, const Solution& initial_solution) {
+                    threaded_gil_release release(evaluation, lns.parameters().number_of_workers);
+                    return lns.optimize(evaluation, initial_solution);
+                },
+                "Runs the search from the passed solution and returns the best solution found.",
+                pybind11::arg("evaluation"), pybind11::arg("initial_solution"))
+            .def("reset_operator_weights", &lns_t::reset_operator_weights,
+                 "Sets the weights of all operators to 1.")
+            .def_property_readonly("parameters", &lns_t::parameters)
+            .def_property_readonly("destroy_operators", &lns_t::destroy_operators)
+            .def_property_readonly("repair_operators", &lns_t::repair_operators)
+            .def_property_readonly("destroy_operator_weights", &lns_t::destroy_operator_weights)
+            .def_property_readonly("repair_operator_weights", &lns_t::repair_operator_weights);
+    }
+
     void bind_large_neighborhood(pybind11::module_& m) {
         using lns_t = routingblocks::adaptive_large_neighborhood;
         using destroy_operator_t = lns_t::destroy_operator_type;
@@ -204,6 +403,11 @@ namespace routingblocks::bindings {
 
         bind_random_insertion_operator(m, repair_operator_interface);
         bind_random_destory_operator(m, destroy_operator_interface);
+        bind_move_selectors(m);
+        bind_cluster_selectors(m);
+        bind_native_destroy_operators(m, destroy_operator_interface);
+        bind_native_repair_operators(m, repair_operator_interface);
+        bind_parallel_large_neighborhood(m);
     }
 
 }  // namespace routingblocks::bindings
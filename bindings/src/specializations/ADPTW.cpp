@@ -42,14 +42,36 @@ namespace routingblocks::bindings {
             .def(pybind11::init<resource_t, resource_t, resource_t>());
         m.def("create_adptw_vertex", &::bindings::helpers::vertex_constructor<ADPTWVertexData>);
         m.def("create_adptw_arc", &::bindings::helpers::arc_constructor<ADPTWArcData>);
+        ::bindings::helpers::bind_relatedness_matrix_builders<ADPTWVertexData, ADPTWArcData>(
+            m, "adptw");
 
-        pybind11::class_<FRVCP<ADPTWLabel>>(m, "ADPTWFacilityPlacementOptimizer")
-            .def(pybind11::init<>([](const Instance& instance, resource_t resource_capacity) {
-                return FRVCP<ADPTWLabel>(instance, std::make_shared<Propagator<ADPTWLabel>>(
-                                                       instance, resource_capacity));
-            }))
-            .def("optimize", &FRVCP<ADPTWLabel>::optimize,
-                 "Solve the detour embedding problem for the specified route.");
+        ::bindings::helpers::bind_typed_route<ADPTWEvaluation>(m, "ADPTWTypedRoute");
+        ::bindings::helpers::bind_typed_swap_operators<ADPTWEvaluation>(m, "ADPTW");
+
+        auto optimizer = pybind11::class_<FRVCP<ADPTWLabel>>(m, "ADPTWFacilityPlacementOptimizer");
+        optimizer.def(pybind11::init<>([](const Instance& instance, resource_t resource_capacity,
+                                          size_t cache_capacity) {
+                          return FRVCP<ADPTWLabel>(
+                              instance,
+                              std::make_shared<Propagator<ADPTWLabel>>(instance, resource_capacity),
+                              cache_capacity);
+                      }),
+                      pybind11::arg("instance"), pybind11::arg("resource_capacity_time"),
+                      pybind11::arg("cache_capacity") = 0);
+        ::bindings::helpers::bind_frvcp<ADPTWLabel>(optimizer);
+
+        auto batch_optimizer = pybind11::class_<BatchFRVCP<ADPTWLabel>>(
+            m, "ADPTWBatchFacilityPlacementOptimizer");
+        batch_optimizer.def(
+            pybind11::init<>([](const Instance& instance, resource_t resource_capacity,
+                                size_t number_of_threads) {
+                return std::make_unique<BatchFRVCP<ADPTWLabel>>(
+                    instance, std::make_shared<Propagator<ADPTWLabel>>(instance, resource_capacity),
+                    number_of_threads);
+            }),
+            pybind11::arg("instance"), pybind11::arg("resource_capacity_time"),
+            pybind11::arg("number_of_threads") = 1, pybind11::keep_alive<1, 2>());
+        ::bindings::helpers::bind_batch_frvcp<ADPTWLabel>(batch_optimizer);
     }
 
 }  // namespace routingblocks::bindings
\ No newline at end of file
@@ -22,6 +22,7 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 
+#include "routingblocks/BidirectionalFRVCP.h"
 #include "routingblocks/NIFTWEvaluation.h"
 #include "routingblocks_bindings/binding_helpers.hpp"
 
@@ -42,16 +43,59 @@ namespace routingblocks::bindings {
             .def(pybind11::init<resource_t, resource_t, resource_t>());
         m.def("create_niftw_vertex", &::bindings::helpers::vertex_constructor<NIFTWVertexData>);
         m.def("create_niftw_arc", &::bindings::helpers::arc_constructor<NIFTWArcData>);
+        ::bindings::helpers::bind_relatedness_matrix_builders<NIFTWVertexData, NIFTWArcData>(
+            m, "niftw");
 
-        pybind11::class_<FRVCP<NIFTWDPLabel>>(m, "NIFTWFacilityPlacementOptimizer")
+        ::bindings::helpers::bind_typed_route<NIFTWEvaluation>(m, "NIFTWTypedRoute");
+        ::bindings::helpers::bind_typed_swap_operators<NIFTWEvaluation>(m, "NIFTW");
+
+        auto optimizer
+            = pybind11::class_<FRVCP<NIFTWDPLabel>>(m, "NIFTWFacilityPlacementOptimizer");
+        optimizer.def(pybind11::init<>([](const Instance& instance, resource_t resource_capacity,
+                                          resource_t replenishment_time, size_t cache_capacity) {
+                          return FRVCP<NIFTWDPLabel>(
+                              instance,
+                              std::make_shared<Propagator<NIFTWDPLabel>>(
+                                  instance, resource_capacity, replenishment_time),
+                              cache_capacity);
+                      }),
+                      pybind11::arg("instance"), pybind11::arg("battery_capacity_time"),
+                      pybind11::arg("replenishment_time"), pybind11::arg("cache_capacity") = 0);
+        ::bindings::helpers::bind_frvcp<NIFTWDPLabel>(optimizer);
+
+        pybind11::class_<BidirectionalFRVCP<NIFTWDPLabel>>(
+            m, "NIFTWBidirectionalFacilityPlacementOptimizer")
             .def(pybind11::init<>([](const Instance& instance, resource_t resource_capacity,
                                      resource_t replenishment_time) {
-                return FRVCP<NIFTWDPLabel>(instance,
-                                           std::make_shared<Propagator<NIFTWDPLabel>>(
-                                               instance, resource_capacity, replenishment_time));
-            }))
-            .def("optimize", &FRVCP<NIFTWDPLabel>::optimize,
-                 "Solve the detour embedding problem for the specified route.");
+                     return std::make_unique<BidirectionalFRVCP<NIFTWDPLabel>>(
+                         instance,
+                         std::make_shared<Propagator<NIFTWDPLabel>>(instance, resource_capacity,
+                                                                    replenishment_time),
+                         std::make_shared<Propagator<NIFTWBackwardDPLabel>>(
+                             instance, resource_capacity, replenishment_time));
+                 }),
+                 pybind11::arg("instance"), pybind11::arg("battery_capacity_time"),
+                 pybind11::arg("replenishment_time"), pybind11::keep_alive<1, 2>())
+            .def("optimize", &BidirectionalFRVCP<NIFTWDPLabel>::optimize,
+                 "Solve the detour embedding problem for the specified route.")
+            .def_property_readonly("number_of_labels",
+                                   &BidirectionalFRVCP<NIFTWDPLabel>::number_of_labels);
+
+        auto batch_optimizer = pybind11::class_<BatchFRVCP<NIFTWDPLabel>>(
+            m, "NIFTWBatchFacilityPlacementOptimizer");
+        batch_optimizer.def(
+            pybind11::init<>([](const Instance& instance, resource_t resource_capacity,
+                                resource_t replenishment_time, size_t number_of_threads) {
+                return std::make_unique<BatchFRVCP<NIFTWDPLabel>>(
+                    instance,
+                    std::make_shared<Propagator<NIFTWDPLabel>>(instance, resource_capacity,
+                                                               replenishment_time),
+                    number_of_threads);
+            }),
+            pybind11::arg("instance"), pybind11::arg("battery_capacity_time"),
+            pybind11::arg("replenishment_time"), pybind11::arg("number_of_threads") = 1,
+            pybind11::keep_alive<1, 2>());
+        ::bindings::helpers::bind_batch_frvcp<NIFTWDPLabel>(batch_optimizer);
     }
 
 }  // namespace routingblocks::bindings
\ No newline at end of file
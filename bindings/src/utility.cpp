@@ -20,8 +20,10 @@
 #include <pybind11/stl.h>
 #include <routingblocks/insertion_cache.h>
 #include <routingblocks/lns_operators.h>
+#include <routingblocks/relatedness_matrix.h>
 #include <routingblocks/removal_cache.h>
 #include <routingblocks/utility/random.h>
+#include <routingblocks_bindings/Evaluation.h>
 #include <routingblocks_bindings/utility.h>
 
 namespace routingblocks::bindings {
@@ -66,20 +68,33 @@ namespace routingblocks::bindings {
                  [](const cache_t::move_t& lhs, const cache_t::move_t& rhs) { return lhs == rhs; });
 
         pybind11::class_<cache_t>(m, "InsertionCache")
-            .def(pybind11::init<const Instance&>(), pybind11::keep_alive<1, 2>())
+            .def(pybind11::init<const Instance&, size_t>(), pybind11::arg("instance"),
+                 pybind11::arg("number_of_threads") = 1, pybind11::keep_alive<1, 2>())
+            .def_property_readonly("number_of_threads", &cache_t::number_of_threads)
             .def("clear", &cache_t::clear, "Resets the cache.")
             .def(
                 "rebuild",
                 [](cache_t& cache, Evaluation& evaluation, const Solution& solution,
                    const std::vector<VertexID>& tracked_vertices) {
+                    threaded_gil_release release(evaluation, cache.number_of_threads());
                     cache.rebuild(evaluation, solution, tracked_vertices.begin(),
                                   tracked_vertices.end());
                 },
                 "Rebuilds the cache from the given solution, tracking insertions of the passed "
                 "vertex ids.")
-            .def("invalidate_route", &cache_t::invalidate_route,
-                 "Removes any moves that were on the passed route and adds moves according to the "
-                 "new route.")
+            .def(
+                "invalidate_route",
+                [](cache_t& cache, const Route& route, size_t route_index) {
+                    if (cache.number_of_threads() > 1) {
+                        // Uses the evaluation passed to rebuild, which has been checked there.
+                        pybind11::gil_scoped_release release;
+                        cache.invalidate_route(route, route_index);
+                    } else {
+                        cache.invalidate_route(route, route_index);
+                    }
+                },
+                "Removes any moves that were on the passed route and adds moves according to the "
+                "new route.")
             .def(
                 "get_best_insertions_for_vertex",
                 [](const cache_t& cache, VertexID vertex_id) {
@@ -109,6 +124,61 @@ namespace routingblocks::bindings {
                 "increasing order.");
     }
 
+    void bind_relatedness_matrix(pybind11::module_& m) {
+        using matrix_t = routingblocks::utility::relatedness_matrix;
+
+        pybind11::class_<matrix_t>(m, "RelatednessMatrix")
+            .def(pybind11::init<>([](const std::vector<std::vector<float>>& matrix,
+                                     size_t number_of_neighbors) {
+                     std::vector<float> relatedness;
+                     relatedness.reserve(matrix.size() * matrix.size());
+                     for (const auto& row : matrix) {
+                         if (row.size() != matrix.size()) {
+                             throw std::runtime_error("Relatedness matrix must be square.");
+                         }
+                         relatedness.insert(relatedness.end(), row.begin(), row.end());
+                     }
+                     return matrix_t(matrix.size(), std::move(relatedness), number_of_neighbors);
+                 }),
+                 pybind11::arg("matrix"), pybind11::arg("number_of_neighbors"))
+            .def_property_readonly("number_of_vertices", &matrix_t::number_of_vertices)
+            .def_property_readonly("number_of_neighbors", &matrix_t::number_of_neighbors)
+            .def("__len__", &matrix_t::number_of_vertices)
+            .def(
+                "__getitem__",
+                [](const matrix_t& matrix, VertexID i) {
+                    if (i >= matrix.number_of_vertices()) {
+                        throw pybind11::index_error();
+                    }
+                    auto row = matrix.row(i);
+                    return std::vector<float>(row.begin(), row.end());
+                },
+                "Returns the relatedness of the passed vertex to every vertex, indexed by vertex "
+                "id.")
+            .def(
+                "relatedness",
+                [](const matrix_t& matrix, VertexID i, VertexID j) {
+                    if (i >= matrix.number_of_vertices() || j >= matrix.number_of_vertices()) {
+                        throw pybind11::index_error();
+                    }
+                    return matrix.relatedness(i, j);
+                },
+                "Returns the relatedness of vertex i to vertex j.", pybind11::arg("i"),
+                pybind11::arg("j"))
+            .def(
+                "neighbors",
+                [](const matrix_t& matrix, VertexID i) {
+                    if (i >= matrix.number_of_vertices()) {
+                        throw pybind11::index_error();
+                    }
+                    auto neighbors = matrix.neighbors(i);
+                    return std::vector<VertexID>(neighbors.begin(), neighbors.end());
+                },
+                "Returns the vertices most related to the passed vertex, ordered by decreasing "
+                "relatedness.",
+                pybind11::arg("vertex_id"));
+    }
+
     void bind_random(pybind11::module_& m) {
         pybind11::class_<routingblocks::utility::random>(m, "Random")
             .def(pybind11::init<>(),
@@ -137,6 +207,7 @@ namespace routingblocks::bindings {
         bind_random(m);
         bind_removal_cache(m);
         bind_insertion_cache(m);
+        bind_relatedness_matrix(m);
         bind_algorithms(m);
     }
 }  // namespace routingblocks::bindings
\ No newline at end of file
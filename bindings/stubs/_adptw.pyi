@@ -82,6 +82,52 @@ def create_adptw_arc(data: ADPTWArcData) -> Arc:
     ...
 
 
+def build_adptw_distance_relatedness_matrix(instance: Instance, number_of_neighbors: int) -> RelatednessMatrix:
+    """
+    Relates vertices by the inverse of the cost of the arc connecting them. Works only with arcs and vertices created
+    using :ref:`create_adptw_arc` and :ref:`create_adptw_vertex`.
+
+    :param instance: The instance.
+    :param number_of_neighbors: The number of most related vertices to store for each vertex.
+    :return: The relatedness matrix.
+    """
+    ...
+
+
+def build_adptw_spatio_temporal_relatedness_matrix(instance: Instance, slack_weight: float, tw_shift_weight: float,
+                                                   number_of_neighbors: int) -> RelatednessMatrix:
+    """
+    Relates vertices i and j by the inverse of t_ij + slack_weight * max(0, e_j - s_i - t_ij - e_i)
+    + tw_shift_weight * max(0, e_i + s_i + t_ij - l_j), i.e., the travel time plus the waiting time and the time window
+    violation incurred when serving j directly after i. Works only with arcs and vertices created using
+    :ref:`create_adptw_arc` and :ref:`create_adptw_vertex`.
+
+    :param instance: The instance.
+    :param slack_weight: The weight of the waiting time.
+    :param tw_shift_weight: The weight of the time window violation.
+    :param number_of_neighbors: The number of most related vertices to store for each vertex.
+    :return: The relatedness matrix.
+    """
+    ...
+
+
+def build_adptw_shaw_relatedness_matrix(instance: Instance, distance_weight: float, demand_weight: float,
+                                        time_weight: float, number_of_neighbors: int) -> RelatednessMatrix:
+    """
+    Shaw relatedness. Relates vertices by the inverse of a weighted sum of their distance, the difference of their
+    demands, and the difference of their earliest arrival times. Each term is normalized by the range of the
+    respective attribute over the instance. Works only with arcs and vertices created using :ref:`create_adptw_arc`
+    and :ref:`create_adptw_vertex`.
+
+    :param instance: The instance.
+    :param distance_weight: The weight of the distance term.
+    :param demand_weight: The weight of the demand term.
+    :param time_weight: The weight of the earliest arrival time term.
+    :param number_of_neighbors: The number of most related vertices to store for each vertex.
+    :return: The relatedness matrix.
+    """
+    ...
+
 class ADPTWEvaluation(PyEvaluation):
     """
     Evaluation for ADPTW problems. Works only with arcs and vertices created using :ref:`create_adptw_arc` and :ref:`create_adptw_vertex`.
@@ -109,11 +155,12 @@ class ADPTWFacilityPlacementOptimizer:
     ADPTW-specific detour insertion algorithm. Inserts visits to replenishment facilities at optimal locations into a route.
     """
 
-    def __init__(self, instance: Instance, resource_capacity_time: float) -> None:
+    def __init__(self, instance: Instance, resource_capacity_time: float, cache_capacity: int = 0) -> None:
         """
 
         :param instance: The instance.
         :param resource_capacity_time: The vehicle's resource capacity expressed in units of time, that is, the time it takes to fully replenish the resource of an empty vehicle.
+        :param cache_capacity: The number of results to memorize. Routes that visit the same customers in the same order as a memorized route are not labeled again. 0 disables memorization.
         """
         ...
 
@@ -124,3 +171,162 @@ class ADPTWFacilityPlacementOptimizer:
         :return: The optimized route as a list of vertex ids.
         """
         ...
+
+    @property
+    def cache_capacity(self) -> int:
+        """
+        The maximum number of memorized results. 0 if memorization is disabled.
+        """
+        ...
+
+    @property
+    def cache_hits(self) -> int:
+        """
+        The number of calls to :meth:`optimize` answered from memorized results.
+        """
+        ...
+
+    @property
+    def cache_misses(self) -> int:
+        """
+        The number of calls to :meth:`optimize` that had to label the route although memorization is enabled.
+        """
+        ...
+
+    @property
+    def number_of_labels(self) -> int:
+        """
+        The number of labels created by the last labeling run. Labels discarded as dominated on creation do not count.
+        """
+        ...
+
+    def clear_cache(self) -> None:
+        """
+        Forgets all memorized results.
+        """
+        ...
+
+
+
+class ADPTWBatchFacilityPlacementOptimizer:
+    """
+    Runs the ADPTW-specific detour insertion algorithm on many routes at once. Routes are independent, so they can be
+    optimized concurrently on multiple threads. Concurrent calls to optimize are serialized.
+    """
+
+    def __init__(self, instance: Instance, resource_capacity_time: float, number_of_threads: int = 1) -> None:
+        """
+
+        :param instance: The instance.
+        :param resource_capacity_time: The vehicle's resource capacity expressed in units of time, that is, the time it takes to fully replenish the resource of an empty vehicle.
+        :param number_of_threads: The number of threads used to optimize routes concurrently.
+        """
+        ...
+
+    @property
+    def number_of_threads(self) -> int: ...
+
+    @overload
+    def optimize(self, routes: List[List[VertexID]]) -> List[List[VertexID]]:
+        """
+        Optimizes each route by inserting visits to replenishment facilities at optimal locations.
+        :param routes: The vertex ids of the routes to optimize.
+        :return: The optimized routes as lists of vertex ids, in the order of the passed routes.
+        """
+        ...
+
+    @overload
+    def optimize(self, solution: Solution) -> List[List[VertexID]]:
+        """
+        Optimizes each route of the solution by inserting visits to replenishment facilities at optimal locations.
+        :param solution: The solution whose routes to optimize.
+        :return: The optimized routes as lists of vertex ids, in the order of the solution's routes.
+        """
+        ...
+
+class ADPTWTypedRoute:
+    """
+    Route storage specialized to the ADPTW evaluation. Keeps vertex ids and ADPTW labels in contiguous arrays and calls
+    the evaluation without virtual dispatch. Use it to evaluate many insertions or removals on a route quickly, and
+    convert it to a regular :ref:`Route` via :meth:`to_route`.
+    Positions follow the same convention as :ref:`Route`, i.e., position 0 is the start depot.
+    """
+
+    @overload
+    def __init__(self, evaluation: ADPTWEvaluation, instance: Instance) -> None:
+        """
+        Creates an empty route.
+        """
+        ...
+
+    @overload
+    def __init__(self, evaluation: ADPTWEvaluation, instance: Instance, vertex_ids: List[VertexID]) -> None:
+        """
+        Creates a route visiting the given vertices. The vertex ids should not include the depot.
+        """
+        ...
+
+    @overload
+    def __init__(self, evaluation: ADPTWEvaluation, instance: Instance, route: Route) -> None:
+        """
+        Creates a typed copy of the passed route.
+        """
+        ...
+
+    @property
+    def cost(self) -> float:
+        ...
+
+    @property
+    def cost_components(self) -> List[float]:
+        ...
+
+    @property
+    def feasible(self) -> bool:
+        ...
+
+    @property
+    def empty(self) -> bool:
+        ...
+
+    @property
+    def vertex_ids(self) -> List[VertexID]:
+        """
+        The ids of all visited vertices, including start and end depot.
+        """
+        ...
+
+    def __len__(self) -> int:
+        ...
+
+    def to_route(self) -> Route:
+        """
+        :return: A regular route visiting the same vertices.
+        """
+        ...
+
+    def remove_segment(self, begin: int, end: int) -> None:
+        """
+        Removes the visits at positions [begin, end).
+        """
+        ...
+
+    def insert_segment_after(self, position: int, vertex_ids: List[VertexID]) -> None:
+        """
+        Inserts visits to the given vertices after the passed position.
+        """
+        ...
+
+    def evaluate_insertion(self, after_position: int, vertex_id: VertexID) -> float:
+        """
+        Computes the cost of the route obtained by inserting a visit to the given vertex after the passed position.
+        Does not modify the route.
+        """
+        ...
+
+    def evaluate_removal(self, begin: int, end: int) -> float:
+        """
+        Computes the cost of the route obtained by removing the visits at positions [begin, end).
+        Does not modify the route.
+        """
+        ...
@@ -185,3 +185,118 @@ class AdaptiveLargeNeighborhood:
         Get an iterator over all registered repair operators.
         """
         ...
+
+
+class ParallelALNSParameters:
+    """
+    Parameters of the :class:`ParallelAdaptiveLargeNeighborhood` solver.
+    """
+
+    #: Number of worker threads, each searching from its own current solution.
+    number_of_workers: int
+    #: Destroy/repair iterations, summed over all workers.
+    number_of_iterations: int
+    #: Lower bound on the fraction of vertices removed in each iteration.
+    min_removal_factor: float
+    #: Upper bound on the fraction of vertices removed in each iteration.
+    max_removal_factor: float
+    #: Iterations of a single worker after which it reports its operator scores.
+    period_length: int
+    #: Smoothing factor for the adaptive weights.
+    smoothing_factor: float
+    #: Score of operators that found a new best solution.
+    new_best_score: float
+    #: Score of operators that improved the worker's current solution.
+    improvement_score: float
+    #: Score of operators that produced an otherwise accepted solution.
+    acceptance_score: float
+    #: Workers accept solutions that cost at most (1 + acceptance_threshold) times the best known cost.
+    acceptance_threshold: float
+
+    def __init__(self) -> None: ...
+
+
+class ParallelAdaptiveLargeNeighborhood:
+    """
+    ALNS solver that runs several workers in parallel. Each worker owns a random number generator, copies of the
+    registered operators, and a current solution. Workers share the best solution found so far and periodically
+    aggregate their operator scores into common weights, which are adapted as in :class:`AdaptiveLargeNeighborhood`
+    once every worker has reported a period.
+
+    Workers restart from the best known solution once their current solution is no longer acceptable. With more than
+    one worker, the search releases the GIL and rejects evaluations and operators implemented in Python.
+    """
+
+    def __init__(self, randgen: Random, parameters: ParallelALNSParameters) -> None:
+        """
+        :param randgen: Random number generator. Seeds the generators of the workers.
+        :param parameters: Parameters of the search.
+        """
+        ...
+
+    def add_destroy_operator(self, destroy_operator: DestroyOperator) -> None:
+        """
+        Register a new destroy operator with weight 1.
+
+        :param destroy_operator: The operator to add.
+        """
+        ...
+
+    def add_repair_operator(self, repair_operator: RepairOperator) -> None:
+        """
+        Register a new repair operator with weight 1.
+
+        :param repair_operator: The operator to add.
+        """
+        ...
+
+    def optimize(self, evaluation: Evaluation, initial_solution: Solution) -> Solution:
+        """
+        Run the search from the passed solution. Operator weights carry over to subsequent calls.
+
+        :param evaluation: The evaluation function to use.
+        :param initial_solution: The solution to start from. Not modified.
+        :return: The best solution found.
+        """
+        ...
+
+    def reset_operator_weights(self) -> None:
+        """
+        Reset the weights of all operators to 1.
+        """
+        ...
+
+    @property
+    def parameters(self) -> ParallelALNSParameters:
+        """
+        Get the parameters of the search.
+        """
+        ...
+
+    @property
+    def destroy_operators(self) -> List[DestroyOperator]:
+        """
+        Get all registered destroy operators.
+        """
+        ...
+
+    @property
+    def repair_operators(self) -> List[RepairOperator]:
+        """
+        Get all registered repair operators.
+        """
+        ...
+
+    @property
+    def destroy_operator_weights(self) -> List[float]:
+        """
+        Get the weights of the registered destroy operators.
+        """
+        ...
+
+    @property
+    def repair_operator_weights(self) -> List[float]:
+        """
+        Get the weights of the registered repair operators.
+        """
+        ...
@@ -17,6 +17,9 @@
 # IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
 # CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
+from typing import Callable, List
+
+
 class _RandomRemovalOperator(DestroyOperator):
     """
     Removes random vertices from the solution. Note that the same vertex may apppear several times, i.e., if two
@@ -38,3 +41,216 @@ class _RandomInsertionOperator(RepairOperator):
         """
         :param random: The :py:class:`routingblocks.Random` instance to use.
         """
+
+
+class _MoveSelector:
+    """
+    Native counterpart of :py:class:`routingblocks.operators.MoveSelector`. Native destroy and repair operators use
+    native move selectors to pick moves without calling back into python.
+    """
+
+    def select(self, number_of_moves: int) -> int:
+        """
+        :param number_of_moves: The length of the sequence of moves, must be positive.
+        :return: The index of the selected move.
+        """
+        ...
+
+
+class _FirstMoveSelector(_MoveSelector):
+    """
+    Selects the first move in the sequence.
+    """
+
+    def __init__(self) -> None:
+        ...
+
+
+class _LastMoveSelector(_MoveSelector):
+    """
+    Selects the last move in the sequence.
+    """
+
+    def __init__(self) -> None:
+        ...
+
+
+class _NthMoveSelector(_MoveSelector):
+    """
+    Selects the nth move in the sequence, or the last move if the sequence has fewer than n moves.
+    """
+
+    def __init__(self, n: int) -> None:
+        """
+        :param n: The (1-based) index of the move to select.
+        """
+        ...
+
+
+class _BlinkMoveSelector(_MoveSelector):
+    """
+    Skips each move with probability :math:`p` and selects the first move that is not skipped. Selects the last move
+    if all moves are skipped.
+    """
+
+    def __init__(self, blink_probability: float, random: Random) -> None:
+        """
+        :param blink_probability: The probability :math:`p` of skipping a move.
+        :param random: The random number generator. The selector uses a copy.
+        """
+        ...
+
+
+class _RandomMoveSelector(_MoveSelector):
+    """
+    Selects a random move from the sequence.
+    """
+
+    def __init__(self, random: Random) -> None:
+        """
+        :param random: The random number generator. The selector uses a copy.
+        """
+        ...
+
+
+class _SeedSelector:
+    """
+    Native counterpart of :py:class:`routingblocks.operators.SeedSelector`.
+    """
+    ...
+
+
+class _StationSeedSelector(_SeedSelector):
+    """
+    Selects a random visit to one of the passed stations that has not been selected yet.
+    """
+
+    def __init__(self, stations: List[Vertex], random: Random) -> None:
+        ...
+
+
+class _ClusterMemberSelector:
+    """
+    Native counterpart of :py:class:`routingblocks.operators.ClusterMemberSelector`.
+    """
+    ...
+
+
+class _DistanceBasedClusterMemberSelector(_ClusterMemberSelector):
+    """
+    Native counterpart of :py:class:`routingblocks.operators.DistanceBasedClusterMemberSelector`.
+    """
+
+    def __init__(self, vertices: List[Vertex], get_distance: Callable[[Vertex, Vertex], float],
+                 min_radius_factor: float, max_radius_factor: float, random: Random) -> None:
+        """
+        :param vertices: The vertices in the instance
+        :param get_distance: A distance function that takes two vertices and returns their distance to each other. Called once for each pair of vertices on construction.
+        :param min_radius_factor: The minimum radius of the cluster as a factor of the maximum distance between any two vertices
+        :param max_radius_factor: The maximum radius of the cluster as a factor of the maximum distance between any two vertices
+        :param random: The random number generator used to pick the radius.
+        """
+        ...
+
+
+class _RelatedRemovalOperator(DestroyOperator):
+    """
+    Native implementation of :py:class:`routingblocks.operators.RelatedRemovalOperator`.
+    """
+
+    def __init__(self, relatedness_matrix: RelatednessMatrix, move_selector: _MoveSelector,
+                 seed_selector: _MoveSelector, initial_seed_selector: _MoveSelector, cluster_size: int = 1) -> None:
+        """
+        :param relatedness_matrix: The relatedness matrix.
+        :param move_selector: Selects the vertex to remove among the remaining vertices, ordered by relatedness to the seed in descending order.
+        :param seed_selector: Selects the next seed among the removed vertices.
+        :param initial_seed_selector: Selects the initial seed among the vertices in the solution.
+        :param cluster_size: The number of related vertices to remove for each seed.
+        """
+        ...
+
+
+class _WorstRemovalOperator(DestroyOperator):
+    """
+    Native implementation of :py:class:`routingblocks.operators.WorstRemovalOperator`.
+    """
+
+    def __init__(self, instance: Instance, move_selector: _MoveSelector) -> None:
+        """
+        :param instance: The problem instance
+        :param move_selector: Selects the next vertex to remove among the removal moves ordered by cost improvement.
+        """
+        ...
+
+
+class _ClusterRemovalOperator(DestroyOperator):
+    """
+    Native implementation of :py:class:`routingblocks.operators.ClusterRemovalOperator`. Unlike the python
+    implementation, each visit is selected at most once even if clusters overlap.
+    """
+
+    def __init__(self, seed_selector: _SeedSelector, cluster_member_selector: _ClusterMemberSelector) -> None:
+        ...
+
+
+class _StationVicinityRemovalOperator(DestroyOperator):
+    """
+    Native implementation of :py:class:`routingblocks.operators.StationVicinityRemovalOperator`.
+    """
+
+    def __init__(self, instance: Instance, get_distance: Callable[[Vertex, Vertex], float],
+                 min_radius_factor: float, max_radius_factor: float, random: Random) -> None:
+        """
+        :param instance: Instance the operator will be applied to
+        :param get_distance: A function taking two vertices and returning the distance between them. Called once for each pair of vertices on construction.
+        :param min_radius_factor: Minimum of the interval the radius is picked from
+        :param max_radius_factor: Maximum of the interval the radius is picked from
+        :param random: Random number generator
+        """
+        ...
+
+
+class _BestInsertionOperator(RepairOperator):
+    """
+    Native implementation of :py:class:`routingblocks.operators.BestInsertionOperator`. Inserts vertices one at a time
+    in the passed order. The move selector picks the insertion position among the positions ordered by cost. Pass a
+    :py:class:`routingblocks.operators.NativeBlinkMoveSelector` to obtain blinking insertion. Stations are not
+    inserted.
+    """
+
+    def __init__(self, instance: Instance, move_selector: _MoveSelector, number_of_threads: int = 1) -> None:
+        """
+        :param instance: The problem instance
+        :param move_selector: The move selector used to choose the insertion position
+        :param number_of_threads: The number of threads used to evaluate insertions, see :py:class:`routingblocks.InsertionCache`.
+        """
+        ...
+
+    @property
+    def number_of_threads(self) -> int:
+        ...
+
+
+class _RegretInsertionOperator(RepairOperator):
+    """
+    Regret-k insertion. Repeatedly ranks the vertices that remain to be inserted by their regret, i.e., the sum of the
+    differences between the cost of inserting a vertex into its best route and into its second to k-th best route, in
+    descending order. Ties are broken by the cost of the best insertion. The vertex selector picks the next vertex from
+    this ranking, which is then inserted at its best position. Pass a
+    :py:class:`routingblocks.operators.NativeBlinkMoveSelector` as vertex selector to add noise. ``k = 1`` yields
+    greedy cheapest insertion. Stations are not inserted.
+    """
+
+    def __init__(self, instance: Instance, k: int = 2, vertex_selector: _MoveSelector = _FirstMoveSelector(),
+                 number_of_threads: int = 1) -> None:
+        """
+        :param instance: The problem instance
+        :param k: The number of routes considered when computing the regret
+        :param vertex_selector: The move selector used to choose the next vertex among the vertices ranked by regret
+        :param number_of_threads: The number of threads used to evaluate insertions, see :py:class:`routingblocks.InsertionCache`.
+        """
+        ...
+
+    @property
+    def number_of_threads(self) -> int:
+        ...
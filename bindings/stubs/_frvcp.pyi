@@ -111,11 +111,12 @@ class FacilityPlacementOptimizer:
     Algorithm that inserts visits to replenishment facilities at optimal locations into a route.
     """
 
-    def __init__(self, instance: Instance, propagator: Propagator) -> None:
+    def __init__(self, instance: Instance, propagator: Propagator, cache_capacity: int = 0) -> None:
         """
 
         :param instance: The instance.
         :param propagator: The propagator to use.
+        :param cache_capacity: The number of results to memorize. Routes that visit the same customers in the same order as a memorized route are not labeled again. 0 disables memorization. Only enable memorization if the propagator's results depend solely on the customer sequence.
         """
         ...
 
@@ -127,3 +128,37 @@ class FacilityPlacementOptimizer:
         :return: The vertex IDs of the optimized route.
         """
         ...
+
+    @property
+    def cache_capacity(self) -> int:
+        """
+        The maximum number of memorized results. 0 if memorization is disabled.
+        """
+        ...
+
+    @property
+    def cache_hits(self) -> int:
+        """
+        The number of calls to :meth:`optimize` answered from memorized results.
+        """
+        ...
+
+    @property
+    def cache_misses(self) -> int:
+        """
+        The number of calls to :meth:`optimize` that had to label the route although memorization is enabled.
+        """
+        ...
+
+    @property
+    def number_of_labels(self) -> int:
+        """
+        The number of labels created by the last labeling run. Labels discarded as dominated on creation do not count.
+        """
+        ...
+
+    def clear_cache(self) -> None:
+        """
+        Forgets all memorized results.
+        """
+        ...
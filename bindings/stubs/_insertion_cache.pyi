@@ -34,7 +34,15 @@ class InsertionMove:
 
 
 class InsertionCache:
-    def __init__(self, instance: Instance) -> None: ...
+    def __init__(self, instance: Instance, number_of_threads: int = 1) -> None:
+        """
+        :param Instance instance: The instance.
+        :param int number_of_threads: The number of threads used to evaluate insertions when rebuilding the cache or invalidating routes.
+        """
+        ...
+
+    @property
+    def number_of_threads(self) -> int: ...
 
     def clear(self) -> None: ...
 
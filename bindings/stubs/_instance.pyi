@@ -60,6 +60,25 @@ class Instance:
         """
         ...
 
+    @overload
+    def __init__(self, vertices: List[Vertex], arc_data: List[List[ADPTWArcData]], fleet_size: int = 0) -> None:
+        """
+        Creates an instance from a matrix of ADPTW arc data. The arc data is stored in a single contiguous block, which
+        is considerably faster and more memory-efficient than creating one :ref:`Arc` per vertex pair.
+
+        :param List[Vertex] vertices: A list of vertices in the order depot, customers, stations
+        :param List[List[ADPTWArcData]] arc_data: The arc data matrix. arc_data[i][j] describes the arc from vertex i to j
+        :param int fleet_size: The number of vehicles in the fleet. Defaults to the number of customers if 0
+        """
+        ...
+
+    @overload
+    def __init__(self, vertices: List[Vertex], arc_data: List[List[NIFTWArcData]], fleet_size: int = 0) -> None:
+        """
+        Creates an instance from a matrix of NIFTW arc data. See the ADPTW overload.
+        """
+        ...
+
     @property
     def fleet_size(self) -> int:
         """
@@ -115,6 +115,13 @@ class LocalSearchOperator:
         """
         ...
 
+    def invalidate_cache(self) -> None:
+        """
+        Discards information cached across searches. Called at the start of each local search run, as the evaluation
+        may have changed in the meantime. Does nothing by default.
+        """
+        ...
+
 
 class PivotingRule:
     """
@@ -182,7 +189,19 @@ class LocalSearch:
     """
 
     def __init__(self, instance: Instance, evaluation: Evaluation, exact_evaluation: Optional[Evaluation],
-                 pivoting_rule: PivotingRule) -> None: ...
+                 pivoting_rule: PivotingRule, number_of_threads: int = 1) -> None:
+        """
+        :param Instance instance: The instance.
+        :param Evaluation evaluation: The evaluation used to find improving moves.
+        :param Optional[Evaluation] exact_evaluation: The evaluation used to compute the exact cost of improving moves. If None, moves are applied to a copy of the solution.
+        :param PivotingRule pivoting_rule: The pivoting rule.
+        :param int number_of_threads: The number of threads used to explore neighborhoods. Only native generator arc operators, e.g., the swap and two-opt operators, are explored in parallel. The result does not depend on the number of threads.
+        """
+        ...
+
+    @property
+    def number_of_threads(self) -> int:
+        ...
 
     def optimize(self, solution: Solution, operators: List[LocalSearchOperator]) -> None:
         """
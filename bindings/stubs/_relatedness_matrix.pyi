@@ -0,0 +1,66 @@
+# Copyright (c) 2023 Patrick S. Klein (@libklein)
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy of
+# this software and associated documentation files (the "Software"), to deal in
+# the Software without restriction, including without limitation the rights to
+# use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+# the Software, and to permit persons to whom the Software is furnished to do so,
+# subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+# FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+# COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+# IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+# CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+class RelatednessMatrix:
+    """
+    Dense matrix of pairwise vertex relatedness stored natively. Larger values indicate more closely related vertices.
+    Additionally stores, for each vertex, the vertices it is most related to, ordered by decreasing relatedness.
+    Can be passed to :py:class:`routingblocks.operators.RelatedRemovalOperator` in place of a list of lists.
+    """
+
+    def __init__(self, matrix: List[List[float]], number_of_neighbors: int) -> None:
+        """
+        :param matrix: Square matrix of relatedness values, indexed by vertex id.
+        :param number_of_neighbors: The number of most related vertices to store for each vertex.
+        """
+        ...
+
+    @property
+    def number_of_vertices(self) -> int:
+        ...
+
+    @property
+    def number_of_neighbors(self) -> int:
+        """
+        The length of each vertex's neighbor list. At most the number of vertices minus one.
+        """
+        ...
+
+    def __len__(self) -> int:
+        ...
+
+    def __getitem__(self, vertex_id: VertexID) -> List[float]:
+        """
+        :param vertex_id: The vertex.
+        :return: The relatedness of the vertex to every vertex, indexed by vertex id.
+        """
+        ...
+
+    def relatedness(self, i: VertexID, j: VertexID) -> float:
+        """
+        :return: The relatedness of vertex i to vertex j.
+        """
+        ...
+
+    def neighbors(self, vertex_id: VertexID) -> List[VertexID]:
+        """
+        :param vertex_id: The vertex.
+        :return: The vertices most related to the passed vertex, ordered by decreasing relatedness.
+        """
+        ...
@@ -28,8 +28,10 @@
 #include <routingblocks/types.h>
 
 #include <array>
-#include <dynamic_bitset/dynamic_bitset.hpp>
+#include <cassert>
+#include <functional>
 #include <optional>
+#include <type_traits>
 #include <vector>
 
 namespace routingblocks {
@@ -106,6 +108,9 @@ namespace routingblocks {
                                             resource_t battery_capacity);
     };
 
+    static_assert(detail::label_holder::stores_inline<ADPTWForwardResourceLabel>
+                  && detail::label_holder::stores_inline<ADPTWBackwardResourceLabel>);
+
     class ADPTWEvaluation
         : public ConcatenationBasedEvaluationImpl<ADPTWEvaluation, ADPTWForwardResourceLabel,
                                                   ADPTWBackwardResourceLabel, ADPTWVertexData,
@@ -360,7 +365,6 @@ namespace routingblocks {
 
     struct ADPTWLabel {
       public:
-        sul::dynamic_bitset<> visited_vertices;
         const ADPTWLabel* predecessor = nullptr;
         VertexID vertex_id = 0;
         resource_t cost = 0;
@@ -368,32 +372,34 @@ namespace routingblocks {
         resource_t t_max = 0;
         resource_t rt_max = 0;
         resource_t num_stations = 0;
-
-        void mark_station_visit() {}
+        // Set if visits are tracked from this label on, i.e., if it resides at a customer.
+        bool clears_visits = false;
 
         [[nodiscard]] bool visited_station() const { return num_stations > 0; }
 
-        void clear_visits() {
-            if (visited_station()) {
-                visited_vertices.reset();
-            } else {
-                visited_vertices.reset();
-                mark_station_visit();
+        void clear_visits() { clears_visits = true; }
+
+        /**
+         * Only vertices visited since the last customer count as visited. These form a short
+         * suffix of the predecessor chain, so walking the chain replaces storing a bitset over
+         * all vertices and keeps labels trivially copyable.
+         */
+        [[nodiscard]] bool visited(VertexID id) const {
+            for (const auto* label = this; !label->root_label(); label = label->predecessor) {
+                if (label->vertex_id == id) return true;
+                if (label->clears_visits) break;
             }
+            return false;
         }
 
-        [[nodiscard]] bool visited(VertexID id) const { return visited_vertices.test(id); }
-
-        void visit_vertex(VertexID v, bool is_station) {
-            visited_vertices.set(v, true);
+        void visit_vertex([[maybe_unused]] VertexID v, bool is_station) {
+            assert(v == vertex_id);
             num_stations += is_station;
         }
 
         ADPTWLabel() = default;
-        explicit ADPTWLabel(size_t number_of_vertices) : visited_vertices(number_of_vertices) {}
         ADPTWLabel(const ADPTWLabel& predecessor, VertexID vertex_id)
-            : visited_vertices(predecessor.visited_vertices),
-              predecessor(&predecessor),
+            : predecessor(&predecessor),
               vertex_id(vertex_id),
               cost(predecessor.cost),
               t_min(predecessor.t_min),
@@ -411,6 +417,8 @@ namespace routingblocks {
         }
     };
 
+    static_assert(std::is_trivially_copyable_v<ADPTWLabel>);
+
     template <> class Propagator<ADPTWLabel> {
         const Instance* _instance;
         resource_t _battery_capacity;
@@ -486,6 +494,15 @@ namespace routingblocks {
                    && label.rt_max + label.t_min <= other.rt_max + other.t_min;
         }
 
+        /**
+         * Key such that dominates(label, other) holds iff every component of the key of label is
+         * at most the corresponding component of the key of other.
+         */
+        std::array<resource_t, 4> dominance_key(const ADPTWLabel& label) {
+            return {label.cost, label.t_min, label.rt_max - (label.t_max - label.t_min),
+                    label.rt_max + label.t_min};
+        }
+
         bool cheaper_than(const ADPTWLabel& label, const ADPTWLabel& other) {
             if (label.cost == other.cost) {
                 return label.num_stations < other.num_stations;
@@ -516,7 +533,11 @@ namespace routingblocks {
 
         void prepare(const std::vector<VertexID>&) {}
 
-        ADPTWLabel create_root_label() { return ADPTWLabel{_instance->NumberOfVertices()}; }
+        [[nodiscard]] size_t parameter_hash() const {
+            return std::hash<resource_t>{}(_battery_capacity);
+        }
+
+        ADPTWLabel create_root_label() { return ADPTWLabel{}; }
     };
 
 }  // namespace routingblocks
@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2023 Patrick S. Klein (@libklein)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef routingblocks_BATCHFRVCP_H
+#define routingblocks_BATCHFRVCP_H
+
+#include <routingblocks/FRVCP.h>
+#include <routingblocks/Instance.h>
+#include <routingblocks/Solution.h>
+#include <routingblocks/utility/thread_pool.h>
+
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace routingblocks {
+
+    /**
+     * Runs FRVCP on a batch of routes. Routes are independent, so with number_of_threads > 1 they
+     * are distributed over a thread pool. Each thread works with a dedicated FRVCP solver, i.e.,
+     * its own label buckets, node queue, label arena, and copy of the propagator.
+     */
+    template <class Label> class BatchFRVCP {
+        using solver_t = FRVCP<Label>;
+        using propagator_t = Propagator<Label>;
+
+        std::vector<std::unique_ptr<solver_t>> _solvers;
+        std::vector<solver_t*> _idle_solvers;
+        std::mutex _idle_solvers_mutex;
+        // Serializes calls to optimize, which share the solvers and the thread pool.
+        std::mutex _optimize_mutex;
+        std::unique_ptr<utility::thread_pool> _thread_pool;
+
+        solver_t* _acquire_solver() {
+            std::lock_guard lock(_idle_solvers_mutex);
+            // There are as many solvers as threads, so one is always idle.
+            auto* solver = _idle_solvers.back();
+            _idle_solvers.pop_back();
+            return solver;
+        }
+
+        void _release_solver(solver_t* solver) {
+            std::lock_guard lock(_idle_solvers_mutex);
+            _idle_solvers.push_back(solver);
+        }
+
+      public:
+        BatchFRVCP(const Instance& instance, std::shared_ptr<propagator_t> propagator,
+                   size_t number_of_threads = 1) {
+            if (number_of_threads == 0) {
+                throw std::runtime_error("BatchFRVCP requires at least one thread.");
+            }
+            for (size_t i = 1; i < number_of_threads; ++i) {
+                if constexpr (std::is_copy_constructible_v<propagator_t>) {
+                    _solvers.push_back(std::make_unique<solver_t>(
+                        instance, std::make_shared<propagator_t>(*propagator)));
+                } else {
+                    throw std::runtime_error(
+                        "The propagator cannot be copied. Multi-threaded FRVCP requires a "
+                        "copyable propagator.");
+                }
+            }
+            _solvers.push_back(std::make_unique<solver_t>(instance, std::move(propagator)));
+            for (const auto& solver : _solvers) {
+                _idle_solvers.push_back(solver.get());
+            }
+            if (number_of_threads > 1) {
+                _thread_pool = std::make_unique<utility::thread_pool>(number_of_threads);
+            }
+        }
+
+        [[nodiscard]] size_t number_of_threads() const { return _solvers.size(); }
+
+        /**
+         * Optimizes each of the passed routes. Returns the optimized routes in the same order.
+         * Concurrent calls are serialized.
+         */
+        std::vector<std::vector<VertexID>> optimize(
+            const std::vector<std::vector<VertexID>>& routes) {
+            std::lock_guard optimize_lock(_optimize_mutex);
+            std::vector<std::vector<VertexID>> optimized_routes(routes.size());
+            auto optimize_route = [&](size_t route_index) {
+                auto* solver = _acquire_solver();
+                try {
+                    optimized_routes[route_index] = solver->optimize(routes[route_index]);
+                } catch (...) {
+                    _release_solver(solver);
+                    throw;
+                }
+                _release_solver(solver);
+            };
+            if (_thread_pool) {
+                _thread_pool->parallel_for(routes.size(), optimize_route);
+            } else {
+                for (size_t i = 0; i < routes.size(); ++i) {
+                    optimize_route(i);
+                }
+            }
+            return optimized_routes;
+        }
+
+        /**
+         * Optimizes every route of the passed solution. Returns the optimized routes, including
+         * start and end depot, in the order of the solution's routes.
+         */
+        std::vector<std::vector<VertexID>> optimize(const Solution& solution) {
+            std::vector<std::vector<VertexID>> routes;
+            routes.reserve(solution.size());
+            for (const auto& route : solution) {
+                auto& vertex_ids = routes.emplace_back();
+                vertex_ids.reserve(route.size());
+                for (const auto& node : route) {
+                    vertex_ids.push_back(node.vertex_id());
+                }
+            }
+            return optimize(routes);
+        }
+    };
+
+}  // namespace routingblocks
+
+#endif  // routingblocks_BATCHFRVCP_H
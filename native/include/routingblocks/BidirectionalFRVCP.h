@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) 2023 Patrick S. Klein (@libklein)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef routingblocks_BIDIRECTIONALFRVCP_H
+#define routingblocks_BIDIRECTIONALFRVCP_H
+
+#include <routingblocks/FRVCP.h>
+#include <routingblocks/Instance.h>
+#include <routingblocks/types.h>
+
+#include <algorithm>
+#include <concepts>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace routingblocks {
+
+    /**
+     * Propagators support bidirectional labeling if they name the label type of the matching
+     * backward propagator as backward_label_t and can join a forward with a backward label.
+     * concatenate(fwd, bwd, vertex) joins a forward and a backward label that both reside at
+     * vertex. It returns the cost of the joint path, or nothing if the joint path is infeasible.
+     * Both propagators expose the cost of their labels through cost(label). Costs must not
+     * decrease during propagation, and the cost of a joint path must be at least the sum of the
+     * costs of the joined labels.
+     *
+     * Propagator<backward_label_t> propagates labels from the end depot along reversed arcs:
+     * propagate(label, origin, target, arc) is called with the arc from target to origin. Its
+     * extract_path returns the vertices from the end depot to the passed label.
+     */
+    template <class Label>
+    concept supports_bidirectional_labeling
+        = requires(Propagator<Label>& propagator,
+                   Propagator<typename Propagator<Label>::backward_label_t>& backward_propagator,
+                   const Label& fwd, const typename Propagator<Label>::backward_label_t& bwd,
+                   const Vertex& vertex) {
+              { propagator.concatenate(fwd, bwd, vertex) }
+                  -> std::convertible_to<std::optional<resource_t>>;
+              { propagator.cost(fwd) } -> std::convertible_to<resource_t>;
+              { backward_propagator.cost(bwd) } -> std::convertible_to<resource_t>;
+          };
+
+    /**
+     * Bidirectional variant of FRVCP. Forward labels are propagated from the start depot and
+     * backward labels from the end depot towards the half-way customer of the route. Both
+     * directions extract their labels in order of cost, always advancing the direction with the
+     * cheaper queue. Labels that reach the half-way customer are joined with the labels of the
+     * other direction that reached it before. A direction stops as soon as its cheapest queued
+     * label plus the cheapest label the other direction can still contribute at the half-way
+     * customer is not cheaper than the best joint path found so far.
+     */
+    template <class Label>
+        requires supports_bidirectional_labeling<Label>
+    class BidirectionalFRVCP {
+        using backward_label_t = typename Propagator<Label>::backward_label_t;
+        using forward_propagator_t = Propagator<Label>;
+        using backward_propagator_t = Propagator<backward_label_t>;
+
+        const Instance* _instance;
+        std::shared_ptr<forward_propagator_t> _forward_propagator;
+        std::shared_ptr<backward_propagator_t> _backward_propagator;
+        FRVCP<Label> _forward_solver;
+        FRVCP<backward_label_t> _backward_solver;
+        size_t _number_of_labels = 0;
+
+      public:
+        BidirectionalFRVCP(const Instance& instance,
+                           std::shared_ptr<forward_propagator_t> forward_propagator,
+                           std::shared_ptr<backward_propagator_t> backward_propagator)
+            : _instance(&instance),
+              _forward_propagator(forward_propagator),
+              _backward_propagator(backward_propagator),
+              _forward_solver(instance, std::move(forward_propagator)),
+              _backward_solver(instance, std::move(backward_propagator)) {}
+
+        /**
+         * Number of labels created by the last call to optimize in both directions.
+         */
+        [[nodiscard]] size_t number_of_labels() const { return _number_of_labels; }
+
+        std::vector<VertexID> optimize(const std::vector<VertexID>& route) {
+            // Layers of the DP graph, i.e., the depots and customers of the route.
+            std::vector<VertexID> customers;
+            for (VertexID vertex_id : route) {
+                if (!_instance->getVertex(vertex_id).station()) {
+                    customers.push_back(vertex_id);
+                }
+            }
+            // Without customers there is nothing to meet at.
+            if (customers.size() < 3) {
+                auto path = _forward_solver.optimize(route);
+                _number_of_labels = _forward_solver.number_of_labels();
+                return path;
+            }
+
+            const size_t meeting_layer = customers.size() / 2;
+            const Vertex& meeting_vertex = _instance->getVertex(customers[meeting_layer]);
+            _forward_solver.start_labeling_towards(route, meeting_layer,
+                                                   LabelingDirection::Forward);
+            _backward_solver.start_labeling_towards(route, meeting_layer,
+                                                    LabelingDirection::Backward);
+
+            constexpr resource_t unbounded = std::numeric_limits<resource_t>::infinity();
+            // Labels that reached the meeting customer and the cheapest among them
+            std::vector<const Label*> forward_labels;
+            std::vector<const backward_label_t*> backward_labels;
+            resource_t cheapest_forward_cost = unbounded;
+            resource_t cheapest_backward_cost = unbounded;
+
+            const Label* best_forward_label = nullptr;
+            const backward_label_t* best_backward_label = nullptr;
+            resource_t best_cost = unbounded;
+            auto join = [&](const Label& forward_label, const backward_label_t& backward_label) {
+                auto cost = _forward_propagator->concatenate(forward_label, backward_label,
+                                                             meeting_vertex);
+                if (cost && *cost < best_cost) {
+                    best_forward_label = &forward_label;
+                    best_backward_label = &backward_label;
+                    best_cost = *cost;
+                }
+            };
+
+            while (true) {
+                const auto* forward_top = _forward_solver.cheapest_queued_label();
+                const auto* backward_top = _backward_solver.cheapest_queued_label();
+                // Lower bounds on the cost of labels extracted from now on
+                const resource_t forward_bound
+                    = forward_top ? _forward_propagator->cost(*forward_top) : unbounded;
+                const resource_t backward_bound
+                    = backward_top ? _backward_propagator->cost(*backward_top) : unbounded;
+                const bool forward_done
+                    = forward_bound + std::min(backward_bound, cheapest_backward_cost)
+                      >= best_cost;
+                const bool backward_done
+                    = backward_bound + std::min(forward_bound, cheapest_forward_cost)
+                      >= best_cost;
+                if (forward_done && backward_done) {
+                    break;
+                }
+
+                if (!forward_done && (backward_done || forward_bound <= backward_bound)) {
+                    if (const Label* label = _forward_solver.label_towards_next()) {
+                        for (const backward_label_t* backward_label : backward_labels) {
+                            join(*label, *backward_label);
+                        }
+                        forward_labels.push_back(label);
+                        cheapest_forward_cost
+                            = std::min(cheapest_forward_cost, _forward_propagator->cost(*label));
+                    }
+                } else {
+                    if (const backward_label_t* label = _backward_solver.label_towards_next()) {
+                        for (const Label* forward_label : forward_labels) {
+                            join(*forward_label, *label);
+                        }
+                        backward_labels.push_back(label);
+                        cheapest_backward_cost
+                            = std::min(cheapest_backward_cost, _backward_propagator->cost(*label));
+                    }
+                }
+            }
+
+            _number_of_labels
+                = _forward_solver.number_of_labels() + _backward_solver.number_of_labels();
+            if (best_forward_label == nullptr) {
+                return route;
+            }
+
+            auto path = _forward_propagator->extract_path(*best_forward_label);
+            const auto backward_path = _backward_propagator->extract_path(*best_backward_label);
+            // The backward path ends at the meeting customer, which path already contains.
+            path.insert(path.end(), std::next(backward_path.rbegin()), backward_path.rend());
+            return path;
+        }
+    };
+
+}  // namespace routingblocks
+
+#endif  // routingblocks_BIDIRECTIONALFRVCP_H
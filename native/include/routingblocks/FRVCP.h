@@ -24,12 +24,22 @@
 #define routingblocks_FRVCP_H
 
 #include <routingblocks/Instance.h>
+#include <routingblocks/types.h>
 #include <routingblocks/utility/heap.h>
+#include <routingblocks/utility/lru_cache.h>
 
 #include <algorithm>
+#include <array>
 #include <bitset>
-#include <deque>
+#include <concepts>
+#include <functional>
 #include <iostream>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
 namespace routingblocks {
 
     using DPVertexID = size_t;
@@ -51,32 +61,103 @@ namespace routingblocks {
         }
     };
 
+    /**
+     * Implicit layered DP graph. Layer 0 holds the start depot. Each subsequent layer holds one
+     * customer of the route, preceded by a copy of every station. Successors are generated on
+     * the fly: a customer connects to the next layer's customer and stations, a station connects
+     * to its layer's customer and to every other station of its layer.
+     */
     class DPGraph {
-        std::deque<DPVertex> _vertices;
-        std::vector<std::vector<DPVertex*>> _successors;
+        // Customer (or depot) of each layer.
+        std::vector<const Vertex*> _layers;
+        std::vector<const Vertex*> _stations;
+
+        [[nodiscard]] size_t _layer_size() const { return _stations.size() + 1; }
+        // DP vertex id of the customer of layer k > 0. Stations of that layer follow it.
+        [[nodiscard]] DPVertexID _customer_id(size_t layer) const {
+            return 1 + (layer - 1) * _layer_size();
+        }
 
       public:
-        [[nodiscard]] size_t size() const { return _vertices.size(); };
-        [[nodiscard]] auto get_successors(DPVertexID of) const {
-            return std::make_pair(_successors[of].begin(), _successors[of].end());
+        DPGraph() = default;
+        template <class StationRange> explicit DPGraph(const StationRange& stations) {
+            for (const Vertex& station : stations) {
+                _stations.push_back(&station);
+            }
         }
 
-        [[nodiscard]] const DPVertex& get_vertex(DPVertexID id) const { return _vertices[id]; }
+        [[nodiscard]] size_t size() const {
+            return _layers.empty() ? 0 : 1 + (_layers.size() - 1) * _layer_size();
+        };
 
-        void clear() {
-            _vertices.clear();
-            for (auto& successor_list : _successors) {
-                successor_list.clear();
+        [[nodiscard]] DPVertex get_vertex(DPVertexID id) const {
+            if (id == 0) {
+                return {id, _layers.front()};
             }
+            const size_t offset = (id - 1) % _layer_size();
+            return {id, offset == 0 ? _layers[(id - 1) / _layer_size() + 1]
+                                    : _stations[offset - 1]};
         }
 
-        DPVertexID add_vertex(const Vertex& vertex) {
-            DPVertexID next_id = _vertices.size();
-            _vertices.emplace_back(next_id, &vertex);
-            _successors.emplace_back();
-            return next_id;
-        };
-        void add_edge(DPVertexID i, DPVertexID j) { _successors[i].push_back(&_vertices[j]); }
+        /**
+         * Calls callback(successor_id, successor_vertex) for every successor of the passed DP
+         * vertex.
+         */
+        template <class Callback>
+        void for_each_successor(DPVertexID of, Callback&& callback) const {
+            const size_t offset = of == 0 ? 0 : (of - 1) % _layer_size();
+            const size_t layer = of == 0 ? 0 : (of - 1) / _layer_size() + 1;
+            if (offset == 0) {
+                // Customer: connect to the next layer
+                if (layer + 1 >= _layers.size()) return;
+                const DPVertexID next_customer = _customer_id(layer + 1);
+                callback(next_customer, *_layers[layer + 1]);
+                for (size_t station = 0; station < _stations.size(); ++station) {
+                    callback(next_customer + 1 + station, *_stations[station]);
+                }
+            } else {
+                // Station: connect to the layer's customer and the layer's other stations
+                const DPVertexID customer = of - offset;
+                callback(customer, *_layers[layer]);
+                for (size_t station = 0; station < _stations.size(); ++station) {
+                    if (station + 1 != offset) {
+                        callback(customer + 1 + station, *_stations[station]);
+                    }
+                }
+            }
+        }
+
+        /**
+         * Calls callback(predecessor_id, predecessor_vertex) for every predecessor of the passed
+         * DP vertex, i.e., enumerates the arcs of the DP graph in reverse.
+         */
+        template <class Callback>
+        void for_each_predecessor(DPVertexID of, Callback&& callback) const {
+            if (of == 0) return;
+            const size_t offset = (of - 1) % _layer_size();
+            const size_t layer = (of - 1) / _layer_size() + 1;
+            const DPVertexID customer = of - offset;
+            // Customers and stations are reached from the previous layer's customer
+            callback(layer_vertex_id(layer - 1), *_layers[layer - 1]);
+            for (size_t station = 0; station < _stations.size(); ++station) {
+                if (station + 1 != offset) {
+                    callback(customer + 1 + station, *_stations[station]);
+                }
+            }
+        }
+
+        [[nodiscard]] size_t number_of_layers() const { return _layers.size(); }
+
+        /**
+         * DP vertex id of the customer (or depot) of the passed layer.
+         */
+        [[nodiscard]] DPVertexID layer_vertex_id(size_t layer) const {
+            return layer == 0 ? 0 : _customer_id(layer);
+        }
+
+        void clear() { _layers.clear(); }
+
+        void add_layer(const Vertex& vertex) { _layers.push_back(&vertex); }
     };
 
     template <class Label> class Propagator {
@@ -84,11 +165,60 @@ namespace routingblocks {
         using label_t = Label;
     };
 
+    /**
+     * Indexed d-ary min-heap of DP vertices. Elements are pairs whose first member is the
+     * DPVertexID of the queued vertex, which is used to locate the element on update.
+     */
     template <class T, class Comparator = std::less<T>> class NodeQueue {
+        static constexpr size_t _arity = 4;
+        static constexpr size_t _not_queued = std::numeric_limits<size_t>::max();
+
         Comparator _compare;
 
         using container_t = std::vector<T>;
         container_t _container;
+        // _position[v] is the index of the element of DP vertex v in _container, or _not_queued.
+        std::vector<size_t> _position;
+
+        void _place(size_t pos, T elem) {
+            _position[elem.first] = pos;
+            _container[pos] = std::move(elem);
+        }
+
+        void _sift_up(size_t pos) {
+            T elem = std::move(_container[pos]);
+            while (pos > 0) {
+                const size_t parent = (pos - 1) / _arity;
+                if (!_compare(elem, _container[parent])) break;
+                _place(pos, std::move(_container[parent]));
+                pos = parent;
+            }
+            _place(pos, std::move(elem));
+        }
+
+        void _sift_down(size_t pos) {
+            T elem = std::move(_container[pos]);
+            const size_t size = _container.size();
+            while (true) {
+                const size_t first_child = pos * _arity + 1;
+                if (first_child >= size) break;
+                const size_t last_child = std::min(first_child + _arity, size);
+                size_t cheapest_child = first_child;
+                for (size_t child = first_child + 1; child < last_child; ++child) {
+                    if (_compare(_container[child], _container[cheapest_child])) {
+                        cheapest_child = child;
+                    }
+                }
+                if (!_compare(_container[cheapest_child], elem)) break;
+                _place(pos, std::move(_container[cheapest_child]));
+                pos = cheapest_child;
+            }
+            _place(pos, std::move(elem));
+        }
+
+        [[nodiscard]] bool _contains(const T& elem) const {
+            return elem.first < _position.size() && _position[elem.first] != _not_queued;
+        }
 
       public:
         NodeQueue() = default;
@@ -96,39 +226,72 @@ namespace routingblocks {
 
         [[nodiscard]] bool empty() const { return _container.empty(); }
 
+        [[nodiscard]] const T& top() const { return _container.front(); }
+
         T extract_cheapest() {
 #ifndef NDEBUG
             if (empty()) {
                 throw std::runtime_error("Cannot extract from empty container!");
             }
 #endif
-            auto min_elem = std::min_element(_container.begin(), _container.end(), _compare);
-
-            std::iter_swap(min_elem, std::prev(_container.end()));
-            T elem = std::move(_container.back());
-            _container.pop_back();
+            T elem = std::move(_container.front());
+            _position[elem.first] = _not_queued;
+            if (_container.size() > 1) {
+                _container.front() = std::move(_container.back());
+                _container.pop_back();
+                _sift_down(0);
+            } else {
+                _container.pop_back();
+            }
 
             return elem;
         }
 
+        /**
+         * Inserts elem if its vertex is not queued yet. Otherwise restores the heap order after
+         * the key of the vertex decreased.
+         */
         void update(const T& elem) {
-            auto pos = std::find(_container.begin(), _container.end(), elem);
-            if (pos == _container.end()) {
+            if (!_contains(elem)) {
                 insert(elem);
+                return;
             }
+            const size_t pos = _position[elem.first];
+            _container[pos] = elem;
+            _sift_up(pos);
         }
 
         void insert(T elem) {
 #ifndef NDEBUG
-            if (std::find(_container.begin(), _container.end(), elem) != _container.end()) {
+            if (_contains(elem)) {
                 throw std::runtime_error(
                     "Cannot insert into NodeQueue. Element already occurs in node queue!");
             }
 #endif
+            if (elem.first >= _position.size()) {
+                _position.resize(elem.first + 1, _not_queued);
+            }
             _container.push_back(std::move(elem));
+            _sift_up(_container.size() - 1);
         }
 
-        void clear() { _container.clear(); }
+        void clear() {
+            for (const auto& elem : _container) {
+                _position[elem.first] = _not_queued;
+            }
+            _container.clear();
+        }
+    };
+
+    /**
+     * Propagators may expose a dominance key to speed up dominance checks. The key of a label is
+     * a fixed-size array of resources such that dominates(label, other) implies
+     * dominance_key(label)[i] <= dominance_key(other)[i] for every component i.
+     */
+    template <class propagator_t, class Label>
+    concept provides_dominance_key = requires(propagator_t& propagator, const Label& label) {
+        { propagator.dominance_key(label)[0] } -> std::convertible_to<resource_t>;
+        std::tuple_size<decltype(propagator.dominance_key(label))>::value;
     };
 
     template <class Label> class LabelBucket {
@@ -146,26 +309,110 @@ namespace routingblocks {
             }
         };
 
+        static auto _dominance_key(propagator_t& propagator, const Label& label) {
+            if constexpr (provides_dominance_key<propagator_t, Label>) {
+                return propagator.dominance_key(label);
+            } else {
+                // Without a key no block can be skipped.
+                return std::array<resource_t, 0>{};
+            }
+        }
+
+        using key_t = decltype(_dominance_key(std::declval<propagator_t&>(),
+                                              std::declval<const Label&>()));
+
+        static bool _key_leq(const key_t& lhs, const key_t& rhs) {
+            for (size_t i = 0; i < lhs.size(); ++i) {
+                if (lhs[i] > rhs[i]) return false;
+            }
+            return true;
+        }
+
+        /**
+         * Settled labels are kept ordered according to should_order_before and split into
+         * blocks of bounded size. Each block stores the component-wise minimum of the dominance
+         * keys of its labels. A block whose minimum key does not lie below the key of a label
+         * cannot contain a dominator of that label and is skipped as a whole.
+         */
+        struct settled_block {
+            std::vector<label_ref_t> labels;
+            key_t min_key;
+
+            void update_min_key(const key_t& key) {
+                for (size_t i = 0; i < key.size(); ++i) {
+                    min_key[i] = std::min(min_key[i], key[i]);
+                }
+            }
+        };
+
+        static constexpr size_t _max_block_size = 64;
+
         propagator_t* _propagator;
         _deref_ptrs_comp _comp;
-        std::vector<label_ref_t> _settled_labels;
+        std::vector<settled_block> _settled_labels;
         util::Heap<label_ref_t, _deref_ptrs_comp> _unsettled_labels;
 
-        decltype(_settled_labels.begin()) _find_dominator(const Label& of_label) {
-            auto dominator = _settled_labels.begin();
-
-            for (; dominator != _settled_labels.end(); ++dominator) {
+        bool _has_dominator(const Label& of_label) {
+            const key_t key = _dominance_key(*_propagator, of_label);
+            for (const auto& block : _settled_labels) {
                 // Abort as soon as a dominator has a higher t_min than of_label.
                 // Any other label will
-                if (_propagator->should_order_before(of_label, **dominator)) {
-                    return _settled_labels.end();
+                if (_propagator->should_order_before(of_label, *block.labels.front())) {
+                    return false;
+                }
+                if (!_key_leq(block.min_key, key)) {
+                    continue;
                 }
-                if (_propagator->dominates(**dominator, of_label)) {
-                    return dominator;
+                for (label_ref_t dominator : block.labels) {
+                    if (_propagator->should_order_before(of_label, *dominator)) {
+                        return false;
+                    }
+                    if (_propagator->dominates(*dominator, of_label)) {
+                        return true;
+                    }
+                }
+            }
+
+            return false;
+        }
+
+        void _settle(label_ref_t label) {
+            const key_t key = _dominance_key(*_propagator, *label);
+            // Insert after all labels that do not order after label
+            auto orders_after_label = [this, label](const label_ref_t& other) {
+                return _propagator->should_order_before(*label, *other);
+            };
+            auto block = std::partition_point(
+                _settled_labels.begin(), _settled_labels.end(),
+                [&](const settled_block& b) { return !orders_after_label(b.labels.back()); });
+            if (block == _settled_labels.end()) {
+                if (_settled_labels.empty()
+                    || _settled_labels.back().labels.size() >= _max_block_size) {
+                    _settled_labels.push_back(settled_block{{}, key});
                 }
+                block = std::prev(_settled_labels.end());
             }
+            block->labels.insert(
+                std::find_if(block->labels.begin(), block->labels.end(), orders_after_label),
+                label);
+            block->update_min_key(key);
 
-            return _settled_labels.end();
+            if (block->labels.size() > _max_block_size) {
+                _split(block);
+            }
+        }
+
+        void _split(typename std::vector<settled_block>::iterator block) {
+            const auto middle = std::next(block->labels.begin(), block->labels.size() / 2);
+            settled_block upper{{middle, block->labels.end()}, {}};
+            block->labels.erase(middle, block->labels.end());
+            for (auto* b : {&*block, &upper}) {
+                b->min_key = _dominance_key(*_propagator, *b->labels.front());
+                for (label_ref_t label : b->labels) {
+                    b->update_min_key(_dominance_key(*_propagator, *label));
+                }
+            }
+            _settled_labels.insert(std::next(block), std::move(upper));
         }
 
       public:
@@ -187,7 +434,7 @@ namespace routingblocks {
             // it becomes the top. If it is the new top, it replaces the old top and thus cannot
             // be dominated (it's cheaper)
             if (_unsettled_labels.empty()) {
-                if (auto dominator = _find_dominator(*label); dominator != _settled_labels.end()) {
+                if (_has_dominator(*label)) {
                     return nullptr;
                 }
             } else {
@@ -195,8 +442,7 @@ namespace routingblocks {
                 // _comp implements operator>
                 if (_comp(prev_top, label)) {
                     // Label replaces prev_top
-                    if (auto dominator = _find_dominator(*label);
-                        dominator != _settled_labels.end()) {
+                    if (_has_dominator(*label)) {
                         return nullptr;
                     }
                 }
@@ -209,18 +455,12 @@ namespace routingblocks {
             // Extract cheapest from _unsettled_labels
             label_ref_t extracted_label = _unsettled_labels.pop();
             // Move cheapest into _settled_labels
-            auto insertion_point
-                = std::upper_bound(_settled_labels.begin(), _settled_labels.end(), extracted_label,
-                                   [this](const label_ref_t& lhs, const label_ref_t& rhs) {
-                                       return _propagator->should_order_before(*lhs, *rhs);
-                                   });
-            _settled_labels.insert(insertion_point, extracted_label);
+            _settle(extracted_label);
 
             // Restore heap invariant - the new top may be dominated by an already settled label
             while (!_unsettled_labels.empty()) {
                 const label_ref_t& current_top = _unsettled_labels.top();
-                if (auto dominator = _find_dominator(*current_top);
-                    dominator != _settled_labels.end()) {
+                if (_has_dominator(*current_top)) {
                     _unsettled_labels.pop();
                 } else {
                     break;
@@ -231,20 +471,49 @@ namespace routingblocks {
         }
     };
 
+    /**
+     * Monotonic arena of labels. Labels are stored in fixed-size chunks that are retained across
+     * calls to free(), which only rewinds the arena and thus runs in O(1). Slots are reused
+     * without being reset, so allocated labels may hold the state of previously freed labels and
+     * have to be overwritten by the caller.
+     */
     template <class Label> class LabelAllocator {
-        std::vector<std::unique_ptr<Label>> _label_slab;
+        static constexpr size_t _chunk_size = 1024;
+
+        std::vector<std::unique_ptr<Label[]>> _chunks;
+        size_t _number_of_allocated_labels = 0;
 
       public:
-        LabelAllocator() : _label_slab(1000){};
+        LabelAllocator() = default;
 
         Label* allocate() {
-            _label_slab.push_back(std::make_unique<Label>());
-            return _label_slab.back().get();
+            const size_t chunk = _number_of_allocated_labels / _chunk_size;
+            if (chunk == _chunks.size()) {
+                _chunks.push_back(std::make_unique<Label[]>(_chunk_size));
+            }
+            return &_chunks[chunk][_number_of_allocated_labels++ % _chunk_size];
         }
 
-        void free() { _label_slab.clear(); }
+        void free() { _number_of_allocated_labels = 0; }
+
+        // Number of labels allocated since the last call to free
+        [[nodiscard]] size_t size() const { return _number_of_allocated_labels; }
 
-        void free_last() { _label_slab.pop_back(); }
+        void free_last() {
+            assert(_number_of_allocated_labels > 0);
+            --_number_of_allocated_labels;
+        }
+    };
+
+    enum class LabelingDirection { Forward, Backward };
+
+    /**
+     * Propagators whose behavior depends on parameters, e.g., the battery capacity, may expose a
+     * hash of these. FRVCP includes it in the keys of cached results.
+     */
+    template <class propagator_t>
+    concept provides_parameter_hash = requires(const propagator_t& propagator) {
+        { propagator.parameter_hash() } -> std::convertible_to<size_t>;
     };
 
     template <class Label> class FRVCP {
@@ -272,11 +541,76 @@ namespace routingblocks {
         label_allocator_t _label_slab;
         DPGraph _graph;
 
+        /**
+         * Result of a previous call to optimize. The customer sequence and parameter hash are
+         * stored to tell hash collisions apart from hits. path is empty if no feasible path
+         * exists.
+         */
+        struct cached_result {
+            std::vector<VertexID> customers;
+            size_t parameter_hash;
+            std::optional<std::vector<VertexID>> path;
+        };
+
+        utility::lru_cache<size_t, cached_result> _result_cache;
+        size_t _cache_hits = 0;
+        size_t _cache_misses = 0;
+        // Customer sequence of the route passed to the last call to optimize
+        std::vector<VertexID> _customers;
+        // Target and direction of the labeling run started by start_labeling_towards
+        DPVertexID _meeting_vertex_id = 0;
+        LabelingDirection _direction = LabelingDirection::Forward;
+
+        size_t _parameter_hash() const {
+            if constexpr (provides_parameter_hash<propagator_t>) {
+                return _propagator->parameter_hash();
+            } else {
+                return 0;
+            }
+        }
+
+        /**
+         * Labels the DP graph of route from the start depot until the first final label is
+         * extracted. Returns the path of that label, or nothing if no feasible path exists.
+         */
+        std::optional<std::vector<VertexID>> _find_path(const std::vector<VertexID>& route) {
+            _start_labeling(route);
+            _add_root_label(0);
+
+            while (!_node_queue.empty()) {
+                auto [extracted_label, origin_vertex_id] = _extract_next_label();
+                const auto origin_dp_vertex = _graph.get_vertex(origin_vertex_id);
+
+                if (_propagator->is_final_label(*extracted_label)) {
+                    // We have found a feasible solution
+                    return _propagator->extract_path(*extracted_label);
+                }
+
+                // Propagate the label to all adjacent vertices
+                const Vertex& origin_vertex = origin_dp_vertex.original_vertex();
+                _graph.for_each_successor(origin_vertex_id, [&](DPVertexID target_dp_vertex_id,
+                                                                const Vertex& target_vertex) {
+                    _propagate(*extracted_label, origin_vertex, target_dp_vertex_id, target_vertex,
+                               _instance.getArc(origin_vertex.id, target_vertex.id));
+                });
+            }
+            return {};
+        }
+
       public:
-        FRVCP(const Instance& instance, std::shared_ptr<propagator_t> propagator)
+        /**
+         * @param cache_capacity Number of results to memorize. Labeling depends only on the
+         * sequence of customers of a route, so routes whose customer sequence matches that of a
+         * memorized result skip labeling. 0 disables the cache. Requires a propagator whose
+         * results do not depend on anything but the customer sequence and its parameter hash.
+         */
+        FRVCP(const Instance& instance, std::shared_ptr<propagator_t> propagator,
+              size_t cache_capacity = 0)
             : _instance(instance),
               _propagator(std::move(propagator)),
-              _node_queue(cheapest_queued_label_comp(*_propagator)) {}
+              _node_queue(cheapest_queued_label_comp(*_propagator)),
+              _graph(instance.Stations()),
+              _result_cache(cache_capacity) {}
 
         // Implementation relies on comparators with references to _propagator and buckets. Copying
         // the Solver with a default copy operator would result in stale references.
@@ -287,7 +621,6 @@ namespace routingblocks {
 
         void clear() {
             _node_queue.clear();
-            _buckets.clear();
             _graph.clear();
             _label_slab.free();
         }
@@ -308,46 +641,24 @@ namespace routingblocks {
             assert(route.back() == 0);
             assert(route.size() >= 2);
             // TODO Make virtual and put in propagator
-
-            VertexID prev_vertex_id = route.front();
-            size_t prev_route_dp_id = _graph.add_vertex(_instance.getVertex(prev_vertex_id));
-
-            for (size_t i = 1u; i < route.size(); ++i) {
-                VertexID cur_vertex_id = route[i];
-                const Vertex& current_vertex = _instance.getVertex(cur_vertex_id);
-                if (current_vertex.station()) {
+            for (VertexID vertex_id : route) {
+                const Vertex& vertex = _instance.getVertex(vertex_id);
+                if (vertex.station()) {
                     continue;
                 }
-                // Add the vertex
-                auto customer_dp_id = _graph.add_vertex(current_vertex);
-                // Connect the vertex
-                _graph.add_edge(prev_route_dp_id, customer_dp_id);
-                // Add stations
-                std::vector<DPVertexID> added_stations;
-                for (const Vertex& station : _instance.Stations()) {
-                    added_stations.push_back(_graph.add_vertex(station));
-                }
-
-                for (DPVertexID station_i : added_stations) {
-                    // Connect to customer
-                    _graph.add_edge(prev_route_dp_id, station_i);
-                    _graph.add_edge(station_i, customer_dp_id);
-                    // Connect to other stations
-                    for (DPVertexID station_j : added_stations) {
-                        if (station_i != station_j) {
-                            _graph.add_edge(station_i, station_j);
-                        }
-                    }
-                }
-
-                prev_route_dp_id = customer_dp_id;
-                prev_vertex_id = cur_vertex_id;
+                _graph.add_layer(vertex);
             }
         }
 
         void _initialize_buckets() {
-            // Create a bucket for each DPVertex
-            _buckets.resize(_graph.size(), LabelBucket(*_propagator));
+            // Create a bucket for each DPVertex. Buckets are retained across calls to keep
+            // their storage.
+            if (_buckets.size() < _graph.size()) {
+                _buckets.resize(_graph.size(), LabelBucket(*_propagator));
+            }
+            for (size_t i = 0; i < _graph.size(); ++i) {
+                _buckets[i].clear();
+            }
         }
 
         void _enqueue(VertexID vertex_id) { _node_queue.insert({vertex_id, &_buckets[vertex_id]}); }
@@ -355,57 +666,156 @@ namespace routingblocks {
             _node_queue.update({vertex_id, &_buckets[vertex_id]});
         }
 
-        std::vector<VertexID> optimize(const std::vector<VertexID>& route) {
+        void _start_labeling(const std::vector<VertexID>& route) {
             assert(route.front() == 0);
             assert(route.back() == 0);
             assert(route.size() >= 2);
             _propagator->prepare(route);
             clear();
 
-            // Build
             _build_graph(route);
             _initialize_buckets();
-            // Initialize root label
-            {
-                auto* root_label = _label_slab.allocate();
-                *root_label = _propagator->create_root_label();
+        }
 
-                _buckets[0].add(root_label);
-                _enqueue(0);
+        void _add_root_label(DPVertexID vertex_id) {
+            auto* root_label = _label_slab.allocate();
+            *root_label = _propagator->create_root_label();
+
+            _buckets[vertex_id].add(root_label);
+            _enqueue(vertex_id);
+        }
+
+        void _propagate(const Label& label, const Vertex& origin_vertex,
+                        DPVertexID target_dp_vertex_id, const Vertex& target_vertex,
+                        const Arc& arc) {
+            if (auto propagated_label
+                = _propagator->propagate(label, origin_vertex, target_vertex, arc);
+                propagated_label) {
+                // Store candidate label
+                Label* next_label = _label_slab.allocate();
+                *next_label = std::move(*propagated_label);
+                if (_buckets[target_dp_vertex_id].add(next_label)) {
+                    _update_queue(target_dp_vertex_id);
+                } else {
+                    // Dominated labels are not referenced anywhere, reuse the slot
+                    _label_slab.free_last();
+                }
             }
+        }
 
-            while (!_node_queue.empty()) {
-                auto [extracted_label, origin_vertex_id] = _extract_next_label();
-                const auto& origin_dp_vertex = _graph.get_vertex(origin_vertex_id);
-                // origin_dp_vertex, nullptr);
+        [[nodiscard]] size_t cache_capacity() const { return _result_cache.capacity(); }
+        [[nodiscard]] size_t cache_hits() const { return _cache_hits; }
+        [[nodiscard]] size_t cache_misses() const { return _cache_misses; }
 
-                if (_propagator->is_final_label(*extracted_label)) {
-                    // We have found a feasible solution
-                    return _propagator->extract_path(*extracted_label);
+        void clear_cache() { _result_cache.clear(); }
+
+        std::vector<VertexID> optimize(const std::vector<VertexID>& route) {
+            if (_result_cache.capacity() == 0) {
+                return _find_path(route).value_or(route);
+            }
+
+            _customers.clear();
+            size_t key = _parameter_hash();
+            for (VertexID vertex_id : route) {
+                if (_instance.getVertex(vertex_id).station()) {
+                    continue;
                 }
+                _customers.push_back(vertex_id);
+                key ^= std::hash<VertexID>{}(vertex_id) + 0x9e3779b97f4a7c15 + (key << 6)
+                       + (key >> 2);
+            }
 
-                // Propagate the label to all adjacent vertices
-                auto [next_target_dp_vertex, target_vertices_end]
-                    = _graph.get_successors(origin_vertex_id);
-                for (; next_target_dp_vertex != target_vertices_end; ++next_target_dp_vertex) {
-                    const auto& target_dp_vertex = **next_target_dp_vertex;
-
-                    if (auto propagated_label = _propagator->propagate(
-                            *extracted_label, origin_dp_vertex.original_vertex(),
-                            target_dp_vertex.original_vertex(),
-                            _instance.getArc(origin_dp_vertex.original_vertex().id,
-                                             target_dp_vertex.original_vertex().id));
-                        propagated_label) {
-                        // Store candidate label
-                        Label* next_label = _label_slab.allocate();
-                        *next_label = std::move(*propagated_label);
-                        if (_buckets[target_dp_vertex.dp_vertex_id()].add(next_label)) {
-                            _update_queue(target_dp_vertex.dp_vertex_id());
-                        }
-                    }
+            if (const auto* result = _result_cache.find(key);
+                result != nullptr && result->customers == _customers
+                && result->parameter_hash == _parameter_hash()) {
+                ++_cache_hits;
+                return result->path.value_or(route);
+            }
+
+            ++_cache_misses;
+            auto path = _find_path(route);
+            _result_cache.insert(key, cached_result{_customers, _parameter_hash(), path});
+            return path.value_or(route);
+        }
+
+        /**
+         * Number of labels created by the last labeling run. Labels discarded as dominated on
+         * creation do not count.
+         */
+        [[nodiscard]] size_t number_of_labels() const { return _label_slab.size(); }
+
+        /**
+         * Starts labeling the DP graph of route from one of its ends towards the customer of
+         * meeting_layer, the index of that customer among the non-station vertices of route.
+         * Forward labeling starts at the start depot. Backward labeling starts at the end depot
+         * and propagates labels along reversed arcs, i.e., from the head to the tail of each arc.
+         * Labels are not propagated beyond the meeting customer and no label is treated as
+         * final. Labels are then extracted one at a time through label_towards_next.
+         */
+        void start_labeling_towards(const std::vector<VertexID>& route, size_t meeting_layer,
+                                    LabelingDirection direction) {
+            _start_labeling(route);
+            if (meeting_layer >= _graph.number_of_layers()) {
+                throw std::runtime_error("Meeting layer exceeds the number of customers!");
+            }
+            _meeting_vertex_id = _graph.layer_vertex_id(meeting_layer);
+            _direction = direction;
+            _add_root_label(direction == LabelingDirection::Forward
+                                ? 0
+                                : _graph.layer_vertex_id(_graph.number_of_layers() - 1));
+        }
+
+        /**
+         * Returns the cheapest label queued by the current labeling run, or nullptr if labeling
+         * has finished. Labels extracted later are never cheaper than this label.
+         */
+        [[nodiscard]] const Label* cheapest_queued_label() const {
+            return _node_queue.empty() ? nullptr : _node_queue.top().second->top();
+        }
+
+        /**
+         * Extracts the cheapest queued label. Returns it if it resides at the meeting customer.
+         * Otherwise propagates it and returns nullptr. Returned labels are non-dominated and
+         * remain valid until the next labeling run of this solver.
+         */
+        const Label* label_towards_next() {
+            auto [extracted_label, origin_vertex_id] = _extract_next_label();
+            if (origin_vertex_id == _meeting_vertex_id) {
+                return extracted_label;
+            }
+
+            const Vertex& origin_vertex = _graph.get_vertex(origin_vertex_id).original_vertex();
+            auto propagate_to = [&](DPVertexID target_dp_vertex_id, const Vertex& target_vertex) {
+                const Arc& arc = _direction == LabelingDirection::Forward
+                                     ? _instance.getArc(origin_vertex.id, target_vertex.id)
+                                     : _instance.getArc(target_vertex.id, origin_vertex.id);
+                _propagate(*extracted_label, origin_vertex, target_dp_vertex_id, target_vertex,
+                           arc);
+            };
+            if (_direction == LabelingDirection::Forward) {
+                _graph.for_each_successor(origin_vertex_id, propagate_to);
+            } else {
+                _graph.for_each_predecessor(origin_vertex_id, propagate_to);
+            }
+            return nullptr;
+        }
+
+        /**
+         * Labels the DP graph of route exhaustively towards the customer of meeting_layer, see
+         * start_labeling_towards. Returns the non-dominated labels that reach the meeting
+         * customer.
+         */
+        std::vector<const Label*> label_towards(const std::vector<VertexID>& route,
+                                                size_t meeting_layer,
+                                                LabelingDirection direction) {
+            start_labeling_towards(route, meeting_layer, direction);
+            std::vector<const Label*> meeting_labels;
+            while (!_node_queue.empty()) {
+                if (const Label* label = label_towards_next()) {
+                    meeting_labels.push_back(label);
                 }
             }
-            return route;
+            return meeting_labels;
         }
     };
 
@@ -36,7 +36,8 @@ namespace routingblocks {
     class Instance {
         // contains [depot, customer_1, ..., customer_n, station_1, ..., station_n]
         std::vector<Vertex> _vertices;
-        std::vector<std::vector<Arc>> _arcs;
+        // Row-major |V| x |V| matrix
+        std::vector<Arc> _arcs;
 
         VertexID _number_of_customers;
         VertexID _number_of_stations;
@@ -54,6 +55,11 @@ namespace routingblocks {
         Instance(Vertex depot, const std::vector<Vertex>& customers,
                  const std::vector<Vertex>& stations, std::vector<std::vector<Arc>> arcs,
                  int fleetSize);
+        /**
+         * Creates an instance from a row-major arc matrix, i.e., arcs[i * |V| + j] is the arc
+         * from vertex i to vertex j. See make_arc_matrix.
+         */
+        Instance(std::vector<Vertex> vertices, std::vector<Arc> arcs, int fleetSize);
 
         [[nodiscard]] const Vertex& getVertex(size_t id) const {
             assert(id < _vertices.size());
@@ -70,7 +76,10 @@ namespace routingblocks {
             return *std::next(_stations_begin, id);
         }
 
-        [[nodiscard]] const Arc& getArc(size_t i, size_t j) const { return _arcs[i][j]; }
+        [[nodiscard]] const Arc& getArc(size_t i, size_t j) const {
+            assert(i < _vertices.size() && j < _vertices.size());
+            return _arcs[i * _vertices.size() + j];
+        }
 
         [[nodiscard]] size_t NumberOfVertices() const { return _vertices.size(); }
 
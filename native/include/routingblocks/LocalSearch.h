@@ -29,9 +29,15 @@ SOFTWARE.*/
 #include <routingblocks/evaluation.h>
 #include <routingblocks/utility/arc_set.h>
 #include <routingblocks/utility/random.h>
+#include <routingblocks/utility/thread_pool.h>
 
+#include <algorithm>
 #include <memory>
+#include <numeric>
+#include <optional>
 #include <set>
+#include <stdexcept>
+#include <unordered_map>
 #include <vector>
 
 namespace routingblocks {
@@ -65,6 +71,28 @@ namespace routingblocks {
 
         virtual void finalize_search() = 0;
 
+        /**
+         * Discards information cached across searches. LocalSearch calls this at the start of
+         * each run as the evaluation may have changed in the meantime.
+         */
+        virtual void invalidate_cache() {}
+
+        /**
+         * Number of independent parts the neighborhood of the solution can be split into for
+         * parallel search. 0 if the operator does not support parallel search.
+         */
+        [[nodiscard]] virtual size_t number_of_partitions(const Solution&) const { return 0; }
+
+        /**
+         * Returns all improving moves in the given part of the neighborhood. Concatenating the
+         * moves of partitions 0, 1, ... yields the moves find_next_improving_move returns in
+         * sequence. Called concurrently between prepare_search and finalize_search.
+         */
+        [[nodiscard]] virtual std::vector<std::shared_ptr<Move>> find_improving_moves(
+            eval_t&, const Solution&, size_t) const {
+            throw std::runtime_error("Operator does not support parallel search.");
+        }
+
         virtual ~Operator() = default;
     };
 
@@ -174,26 +202,133 @@ namespace routingblocks {
         }
     };
 
-    template <class move_t>
+    /**
+     * Operator that explores the neighborhood spanned by generator arcs. Moves are evaluated
+     * using evaluation_t. Passing a concrete evaluation type, e.g., ADPTWEvaluation, binds move
+     * evaluation at compile time. Defaults to the virtual Evaluation interface.
+     */
+    template <class move_t, class evaluation_t = Evaluation>
         requires std::is_base_of_v<GeneratorArcMove<move_t>, move_t>
+                 && std::derived_from<evaluation_t, Evaluation>
     class GeneratorArcOperator : public Operator {
       protected:
+        /**
+         * Static move descriptor of an (origin route, target route) pair. Records the improving
+         * moves between both routes as long as neither route has been modified, which allows
+         * skipping their re-evaluation in subsequent searches.
+         */
+        struct route_pair_cache {
+            size_t origin_timestamp = 0;
+            size_t target_timestamp = 0;
+            // Number of origin positions whose moves have been evaluated completely
+            size_t evaluated_origins = 0;
+            // First target position not yet evaluated for origin position evaluated_origins
+            size_t next_target = 0;
+            // (origin position, target position) of the improving moves, in search order
+            std::vector<std::pair<size_t, size_t>> improving_moves;
+        };
+
         const Instance& _instance;
         const utility::arc_set* _arc_set;
+        // Candidate targets of the current origin
+        std::vector<NodeLocation> _targets;
 
-        QuadraticNeighborhoodIterator _get_next_arc(const Solution& solution, const Move* move) {
-            if (move == nullptr) {
-                return QuadraticNeighborhoodIterator(
-                    solution, GeneratorArc{solution.begin(), solution.begin()->begin(),
-                                           solution.begin(), solution.begin()->begin()});
+        std::unordered_map<size_t, route_pair_cache> _route_pair_cache;
+        const Evaluation* _cached_evaluation = nullptr;
+        size_t _cached_number_of_routes = 0;
+
+        static evaluation_t& _get_evaluation(eval_t& evaluation) {
+            if constexpr (std::is_same_v<evaluation_t, eval_t>) {
+                return evaluation;
             } else {
-                auto* arc_move = static_cast<const move_t*>(move);
-                auto [origin_route, origin_node] = to_iter(arc_move->origin(), solution);
-                auto [target_route, target_node] = to_iter(arc_move->target(), solution);
-                auto iter = QuadraticNeighborhoodIterator(
-                    solution, GeneratorArc{origin_route, origin_node, target_route, target_node});
-                return ++iter;
+                auto* typed_evaluation = dynamic_cast<evaluation_t*>(&evaluation);
+                if (typed_evaluation == nullptr) {
+                    throw std::runtime_error(
+                        "Operator is specialized to a different evaluation type than the one "
+                        "passed.");
+                }
+                return *typed_evaluation;
+            }
+        }
+
+        /**
+         * Collects the locations of the nodes the arc set connects the origin vertex to, in
+         * solution order. Uses the solution's vertex lookup, so each origin costs O(k log k) for
+         * k candidate nodes rather than O(|solution|).
+         */
+        void _collect_candidates(const Solution& solution, VertexID origin_vertex_id,
+                                 std::vector<NodeLocation>& targets) const {
+            targets.clear();
+            _arc_set->for_each_target(origin_vertex_id, [&](VertexID target_vertex_id) {
+                const auto& locations = solution.find(target_vertex_id);
+                targets.insert(targets.end(), locations.begin(), locations.end());
+            });
+            std::sort(targets.begin(), targets.end());
+        }
+
+        /**
+         * Calls visit(target_position) for the targets of origin in the passed route, starting
+         * at first_position. Considers only the candidates if an arc set is used. Stops once visit
+         * returns true.
+         */
+        template <class Visitor>
+        bool _visit_route_targets(const Solution& solution, NodeLocation origin,
+                                  size_t target_route, size_t first_position,
+                                  const std::vector<NodeLocation>& candidates,
+                                  Visitor&& visit) const {
+            if (_arc_set) {
+                for (auto next_candidate
+                     = std::lower_bound(candidates.begin(), candidates.end(),
+                                        NodeLocation(target_route, first_position));
+                     next_candidate != candidates.end() && next_candidate->route == target_route;
+                     ++next_candidate) {
+                    if (*next_candidate != origin && visit(next_candidate->position)) {
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            for (size_t position = first_position, route_size = solution[target_route].size();
+                 position < route_size; ++position) {
+                if (NodeLocation(target_route, position) != origin && visit(position)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void _prepare_cache(const Evaluation& evaluation, const Solution& solution) {
+            if (&evaluation != _cached_evaluation || solution.size() != _cached_number_of_routes) {
+                invalidate_cache();
+                _cached_evaluation = &evaluation;
+                _cached_number_of_routes = solution.size();
+            }
+        }
+
+        /**
+         * Returns the cache entry of the passed route pair, reset if either route has been
+         * modified since. nullptr if one of the routes is empty. These pairs are not cached to
+         * keep the cache small for solutions with many unused vehicles.
+         */
+        route_pair_cache* _get_cache_entry(const Solution& solution, size_t origin_route,
+                                           size_t target_route) {
+            const auto origin_timestamp = solution[origin_route].modification_timestamp();
+            const auto target_timestamp = solution[target_route].modification_timestamp();
+            if (origin_timestamp == 0 || target_timestamp == 0) {
+                return nullptr;
+            }
+
+            auto& entry = _route_pair_cache[origin_route * solution.size() + target_route];
+            if (entry.origin_timestamp != origin_timestamp
+                || entry.target_timestamp != target_timestamp) {
+                entry.origin_timestamp = origin_timestamp;
+                entry.target_timestamp = target_timestamp;
+                entry.evaluated_origins = 0;
+                entry.next_target = 0;
+                entry.improving_moves.clear();
             }
+            return &entry;
         }
 
       public:
@@ -202,35 +337,130 @@ namespace routingblocks {
 
         void prepare_search(const Solution&) override {}
 
+        void invalidate_cache() override {
+            _route_pair_cache.clear();
+            _cached_evaluation = nullptr;
+            _cached_number_of_routes = 0;
+        }
+
         std::shared_ptr<Move> find_next_improving_move(eval_t& evaluation, const Solution& solution,
                                                        const Move* previous_move) override {
-            auto neighborhood_iter = _get_next_arc(solution, previous_move);
-
-            // Iterate over all arcs in the solution
-            const auto end_iter = QuadraticNeighborhoodIterator();
-            for (; neighborhood_iter != end_iter; ++neighborhood_iter) {
-                if (neighborhood_iter->origin_route == neighborhood_iter->target_route
-                    && neighborhood_iter->origin_node == neighborhood_iter->target_node) {
-                    continue;
-                }
-                if (_arc_set
-                    && !_arc_set->includes_arc(neighborhood_iter->origin_node->vertex_id(),
-                                               neighborhood_iter->target_node->vertex_id())) {
-                    continue;
-                }
-                // TODO Can improve - carry index
-                NodeLocation origin = location_cast(solution, neighborhood_iter->origin_route,
-                                                    neighborhood_iter->origin_node);
-                NodeLocation target = location_cast(solution, neighborhood_iter->target_route,
-                                                    neighborhood_iter->target_node);
-                if (const move_t& move = create_move(origin, target);
-                    move.evaluate(evaluation, _instance, solution) < 0) {
-                    return std::make_shared<move_t>(move);
+            auto& typed_evaluation = _get_evaluation(evaluation);
+            _prepare_cache(evaluation, solution);
+
+            NodeLocation origin(0, 0);
+            std::optional<NodeLocation> resume_after;
+            if (previous_move != nullptr) {
+                const auto* arc_move = static_cast<const move_t*>(previous_move);
+                origin = arc_move->origin();
+                resume_after = arc_move->target();
+            }
+
+            std::shared_ptr<Move> improving_move;
+            for (; origin.route < solution.size(); ++origin.route, origin.position = 0) {
+                const auto& origin_route = solution[origin.route];
+                for (auto origin_node = std::next(origin_route.begin(), origin.position);
+                     origin_node != origin_route.end(); ++origin_node, ++origin.position) {
+                    if (_arc_set) {
+                        _collect_candidates(solution, origin_node->vertex_id(), _targets);
+                    }
+
+                    for (size_t target_route = resume_after ? resume_after->route : 0;
+                         target_route < solution.size(); ++target_route) {
+                        const size_t first_position
+                            = resume_after && resume_after->route == target_route
+                                  ? resume_after->position + 1
+                                  : 0;
+                        auto* cache = _get_cache_entry(solution, origin.route, target_route);
+
+                        if (cache && origin.position < cache->evaluated_origins) {
+                            // Neither route changed since this origin has been evaluated
+                            auto cached_move = std::lower_bound(
+                                cache->improving_moves.begin(), cache->improving_moves.end(),
+                                std::make_pair(origin.position, first_position));
+                            if (cached_move != cache->improving_moves.end()
+                                && cached_move->first == origin.position) {
+                                return std::make_shared<move_t>(create_move(
+                                    origin, NodeLocation(target_route, cached_move->second)));
+                            }
+                            continue;
+                        }
+
+                        // Record the evaluation only if it continues where the cache left off
+                        const bool record = cache && origin.position == cache->evaluated_origins
+                                            && first_position == cache->next_target;
+                        if (_visit_route_targets(
+                                solution, origin, target_route, first_position, _targets,
+                                [&](size_t target_position) {
+                                    const move_t& move = create_move(
+                                        origin, NodeLocation(target_route, target_position));
+                                    const bool improving
+                                        = move.evaluate(typed_evaluation, _instance, solution) < 0;
+                                    if (record) {
+                                        cache->next_target = target_position + 1;
+                                        if (improving) {
+                                            cache->improving_moves.emplace_back(origin.position,
+                                                                                target_position);
+                                        }
+                                    }
+                                    if (improving) {
+                                        improving_move = std::make_shared<move_t>(move);
+                                    }
+                                    return improving;
+                                })) {
+                            return improving_move;
+                        }
+                        if (record) {
+                            ++cache->evaluated_origins;
+                            cache->next_target = 0;
+                        }
+                    }
+                    resume_after.reset();
                 }
             }
             return {};
         }
 
+        [[nodiscard]] size_t number_of_partitions(const Solution& solution) const override {
+            return std::accumulate(
+                solution.begin(), solution.end(), size_t(0),
+                [](size_t acc, const Route& route) { return acc + route.size(); });
+        }
+
+        // Partition i contains the generator arcs originating at the i-th node of the solution.
+        [[nodiscard]] std::vector<std::shared_ptr<Move>> find_improving_moves(
+            eval_t& evaluation, const Solution& solution, size_t partition) const override {
+            auto& typed_evaluation = _get_evaluation(evaluation);
+            std::vector<std::shared_ptr<Move>> moves;
+
+            size_t origin_route_index = 0;
+            for (; partition >= solution[origin_route_index].size(); ++origin_route_index) {
+                partition -= solution[origin_route_index].size();
+            }
+            const NodeLocation origin(origin_route_index, partition);
+
+            std::vector<NodeLocation> candidates;
+            if (_arc_set) {
+                _collect_candidates(
+                    solution,
+                    std::next(solution[origin.route].begin(), origin.position)->vertex_id(),
+                    candidates);
+            }
+            for (size_t target_route = 0; target_route < solution.size(); ++target_route) {
+                _visit_route_targets(solution, origin, target_route, 0, candidates,
+                                     [&](size_t target_position) {
+                                         const move_t& move = create_move(
+                                             origin, NodeLocation(target_route, target_position));
+                                         if (move.evaluate(typed_evaluation, _instance, solution)
+                                             < 0) {
+                                             moves.push_back(std::make_shared<move_t>(move));
+                                         }
+                                         return false;
+                                     });
+            }
+            return moves;
+        }
+
         auto create_move(NodeLocation origin, NodeLocation target) const {
             return move_t(origin, target);
         }
@@ -334,8 +564,16 @@ namespace routingblocks {
 
         solution_t _current_solution;
 
+        // Workers for parallel neighborhood exploration. nullptr if the search is sequential.
+        std::unique_ptr<utility::thread_pool> _thread_pool;
+
         void _apply_move(const Move& move);
-        cost_t _test_move(const Move& move);
+        cost_t _test_move(const Move& move) const;
+        /**
+         * Searches the neighborhood of the passed operator in parallel. Returns false if the
+         * pivoting rule terminated the search.
+         */
+        bool _explore_neighborhood_in_parallel(Operator& op);
         [[nodiscard]] std::shared_ptr<Move> _explore_neighborhood();
 
       public:
@@ -348,6 +586,9 @@ namespace routingblocks {
             // TODO Figure out a better way to do this.
             _operators.clear();
             std::copy(operators_begin, operators_end, std::back_inserter(_operators));
+            for (auto* op : _operators) {
+                op->invalidate_cache();
+            }
 
             for (loopID = 0; true; loopID++) {
                 std::shared_ptr<Move> first_improving_move = _explore_neighborhood();
@@ -360,9 +601,19 @@ namespace routingblocks {
             sol = std::move(_current_solution);
         }
 
-        // Constructor
+        /**
+         * Creates a local search. With number_of_threads > 1, the neighborhoods of operators that
+         * support parallel search are explored concurrently. Moves are still passed to the
+         * pivoting rule in the sequential order, so the result does not depend on the number
+         * of threads. See Evaluation for the resulting requirements on the evaluations.
+         */
         LocalSearch(const routingblocks::Instance& instance, std::shared_ptr<eval_t> evaluation,
-                    std::shared_ptr<eval_t> exact_evaluation, PivotingRule* pivoting_rule);
+                    std::shared_ptr<eval_t> exact_evaluation, PivotingRule* pivoting_rule,
+                    size_t number_of_threads = 1);
+
+        [[nodiscard]] size_t number_of_threads() const {
+            return _thread_pool ? _thread_pool->size() : 1;
+        }
     };
 
 }  // namespace routingblocks
@@ -26,9 +26,11 @@
 #include <routingblocks/evaluation.h>
 #include <routingblocks/types.h>
 
+#include <array>
+#include <cassert>
+#include <functional>
 #include <optional>
-
-#include "dynamic_bitset/dynamic_bitset.hpp"
+#include <type_traits>
 
 namespace routingblocks {
 
@@ -87,6 +89,9 @@ namespace routingblocks {
         }
     };
 
+    static_assert(detail::label_holder::stores_inline<NIFTWForwardLabel>
+                  && detail::label_holder::stores_inline<NIFTWBackwardLabel>);
+
     class NIFTWEvaluation
         : public ConcatenationBasedEvaluationImpl<NIFTWEvaluation, NIFTWForwardLabel,
                                                   NIFTWBackwardLabel, NIFTWVertexData,
@@ -152,24 +157,32 @@ namespace routingblocks {
 
     struct NIFTWDPLabel {
       public:
-        sul::dynamic_bitset<> visited_vertices;
         const NIFTWDPLabel* predecessor = nullptr;
         VertexID vertex_id = 0;
         resource_t cost = 0;
         resource_t t_min = 0;
         resource_t t_rt = 0;
+        // Set if visits are tracked from this label on, i.e., if it resides at a customer.
+        bool clears_visits = false;
 
-        void clear_visits() { visited_vertices.reset(); }
+        void clear_visits() { clears_visits = true; }
 
-        [[nodiscard]] bool visited(VertexID id) const { return visited_vertices.test(id); }
+        // Vertices visited since the last customer, see ADPTWLabel::visited.
+        [[nodiscard]] bool visited(VertexID id) const {
+            for (const auto* label = this; !label->root_label(); label = label->predecessor) {
+                if (label->vertex_id == id) return true;
+                if (label->clears_visits) break;
+            }
+            return false;
+        }
 
-        void visit_vertex(VertexID v, bool is_station) { visited_vertices.set(v, true); }
+        void visit_vertex([[maybe_unused]] VertexID v, [[maybe_unused]] bool is_station) {
+            assert(v == vertex_id);
+        }
 
         NIFTWDPLabel() = default;
-        explicit NIFTWDPLabel(size_t number_of_vertices) : visited_vertices(number_of_vertices) {}
         NIFTWDPLabel(const NIFTWDPLabel& predecessor, VertexID vertex_id)
-            : visited_vertices(predecessor.visited_vertices),
-              predecessor(&predecessor),
+            : predecessor(&predecessor),
               vertex_id(vertex_id),
               cost(predecessor.cost),
               t_min(predecessor.t_min),
@@ -184,12 +197,60 @@ namespace routingblocks {
         }
     };
 
+    static_assert(std::is_trivially_copyable_v<NIFTWDPLabel>);
+
+    /**
+     * Label of the backward DP, which starts at the end depot. t_max is the latest arrival time
+     * at the label's vertex that keeps the remaining path feasible, t_rt the consumption from the
+     * label's vertex to the next station or the end depot.
+     */
+    struct NIFTWBackwardDPLabel {
+      public:
+        const NIFTWBackwardDPLabel* predecessor = nullptr;
+        VertexID vertex_id = 0;
+        resource_t cost = 0;
+        resource_t t_max = 0;
+        resource_t t_rt = 0;
+        // Set if visits are tracked from this label on, i.e., if it resides at a customer.
+        bool clears_visits = false;
+
+        void clear_visits() { clears_visits = true; }
+
+        // Vertices visited since the last customer, see ADPTWLabel::visited.
+        [[nodiscard]] bool visited(VertexID id) const {
+            for (const auto* label = this; !label->root_label(); label = label->predecessor) {
+                if (label->vertex_id == id) return true;
+                if (label->clears_visits) break;
+            }
+            return false;
+        }
+
+        NIFTWBackwardDPLabel() = default;
+        NIFTWBackwardDPLabel(const NIFTWBackwardDPLabel& predecessor, VertexID vertex_id)
+            : predecessor(&predecessor),
+              vertex_id(vertex_id),
+              cost(predecessor.cost),
+              t_max(predecessor.t_max),
+              t_rt(predecessor.t_rt) {}
+
+        [[nodiscard]] bool root_label() const { return predecessor == nullptr; }
+
+        friend std::ostream& operator<<(std::ostream& out, const NIFTWBackwardDPLabel& l) {
+            out << "[c: " << l.cost << ", t_max: " << l.t_max << ", t_rt: " << l.t_rt << "]";
+            return out;
+        }
+    };
+
+    static_assert(std::is_trivially_copyable_v<NIFTWBackwardDPLabel>);
+
     template <> class Propagator<NIFTWDPLabel> {
         const Instance* _instance;
         resource_t _battery_capacity;
         resource_t _replenishment_time;
 
       public:
+        using backward_label_t = NIFTWBackwardDPLabel;
+
         explicit Propagator(const Instance& instance, resource_t battery_capacity,
                             resource_t replenishment_time)
             : _instance(&instance),
@@ -197,14 +258,13 @@ namespace routingblocks {
               _replenishment_time(replenishment_time){};
 
         std::optional<NIFTWDPLabel> propagate(const NIFTWDPLabel& predecessor, const Vertex& origin,
-                                              const Vertex& target,
-                                              [[maybe_unused]] const Arc& arc) {
+                                              const Vertex& target, const Arc& arc) {
             using std::max;
             using std::min;
             VertexID target_id = target.id;
             const auto& origin_vertex_data = origin.get_data<NIFTWVertexData>();
-            const auto& target_vertex_data = origin.get_data<NIFTWVertexData>();
-            const auto& arc_data = origin.get_data<NIFTWArcData>();
+            const auto& target_vertex_data = target.get_data<NIFTWVertexData>();
+            const auto& arc_data = arc.get_data<NIFTWArcData>();
 
             const auto Q = _battery_capacity;
             const auto g = _replenishment_time;
@@ -249,6 +309,16 @@ namespace routingblocks {
                    && label.t_rt <= other.t_rt;
         }
 
+        /**
+         * Key such that dominates(label, other) holds iff every component of the key of label is
+         * at most the corresponding component of the key of other.
+         */
+        std::array<resource_t, 3> dominance_key(const NIFTWDPLabel& label) {
+            return {label.cost, label.t_min, label.t_rt};
+        }
+
+        resource_t cost(const NIFTWDPLabel& label) const { return label.cost; }
+
         bool cheaper_than(const NIFTWDPLabel& label, const NIFTWDPLabel& other) {
             return label.cost < other.cost;
         }
@@ -275,7 +345,147 @@ namespace routingblocks {
 
         void prepare(const std::vector<VertexID>&) {}
 
-        NIFTWDPLabel create_root_label() { return NIFTWDPLabel{_instance->NumberOfVertices()}; }
+        [[nodiscard]] size_t parameter_hash() const {
+            return std::hash<resource_t>{}(_battery_capacity) * 31
+                   + std::hash<resource_t>{}(_replenishment_time);
+        }
+
+        NIFTWDPLabel create_root_label() { return NIFTWDPLabel{}; }
+
+        /**
+         * Joins a forward and a backward label residing at vertex. The joint path is feasible if
+         * the vehicle arrives in time for the remaining path and the battery suffices until the
+         * next station.
+         */
+        std::optional<resource_t> concatenate(const NIFTWDPLabel& fwd,
+                                              const NIFTWBackwardDPLabel& bwd,
+                                              [[maybe_unused]] const Vertex& vertex) {
+            if (fwd.t_min > bwd.t_max || fwd.t_rt + bwd.t_rt > _battery_capacity) {
+                return {};
+            }
+            return fwd.cost + bwd.cost;
+        }
+    };
+
+    /**
+     * Propagates labels from the end depot towards the start depot. Mirrors
+     * Propagator<NIFTWDPLabel>: a path is feasible backward iff it is feasible forward.
+     */
+    template <> class Propagator<NIFTWBackwardDPLabel> {
+        const Instance* _instance;
+        resource_t _battery_capacity;
+        resource_t _replenishment_time;
+
+      public:
+        explicit Propagator(const Instance& instance, resource_t battery_capacity,
+                            resource_t replenishment_time)
+            : _instance(&instance),
+              _battery_capacity(battery_capacity),
+              _replenishment_time(replenishment_time){};
+
+        /**
+         * Extends the label at origin to target, which precedes origin on the path. arc leads
+         * from target to origin.
+         */
+        std::optional<NIFTWBackwardDPLabel> propagate(const NIFTWBackwardDPLabel& successor,
+                                                      const Vertex& origin, const Vertex& target,
+                                                      const Arc& arc) {
+            using std::min;
+            VertexID target_id = target.id;
+            const auto& origin_vertex_data = origin.get_data<NIFTWVertexData>();
+            const auto& target_vertex_data = target.get_data<NIFTWVertexData>();
+            const auto& arc_data = arc.get_data<NIFTWArcData>();
+
+            // Target i precedes origin j on the path
+            const auto Q = _battery_capacity;
+            const auto g = target.is_station ? _replenishment_time : 0;
+            const auto e_j = origin_vertex_data.earliest_arrival_time;
+            const auto l_i = target_vertex_data.latest_arrival_time;
+            const auto t_ij = arc_data.duration + target_vertex_data.service_time;
+            const auto q_ij = arc_data.consumption;
+
+            // Avoid cycling
+            if (successor.visited(target_id)) {
+                return {};
+            }
+
+            // The vehicle arrives at j no earlier than e_j, plus g if it replenishes at i
+            if (e_j + g > successor.t_max) {
+                return {};
+            }
+
+            NIFTWBackwardDPLabel label(successor, target_id);
+
+            // Reset visited stations when reaching a customer.
+            if (target.customer()) {
+                label.clear_visits();
+            }
+
+            label.cost += arc_data.cost;
+            label.t_max = min(l_i, successor.t_max - g - t_ij);
+            label.t_rt += q_ij;
+
+            if (label.t_rt > Q) {
+                return {};
+            }
+            if (target.is_station) {
+                label.t_rt = 0;
+            }
+
+            return label;
+        }
+
+        bool dominates(const NIFTWBackwardDPLabel& label, const NIFTWBackwardDPLabel& other) {
+            return label.cost <= other.cost && label.t_max >= other.t_max
+                   && label.t_rt <= other.t_rt;
+        }
+
+        /**
+         * Key such that dominates(label, other) holds iff every component of the key of label is
+         * at most the corresponding component of the key of other.
+         */
+        std::array<resource_t, 3> dominance_key(const NIFTWBackwardDPLabel& label) {
+            return {label.cost, -label.t_max, label.t_rt};
+        }
+
+        resource_t cost(const NIFTWBackwardDPLabel& label) const { return label.cost; }
+
+        bool cheaper_than(const NIFTWBackwardDPLabel& label, const NIFTWBackwardDPLabel& other) {
+            return label.cost < other.cost;
+        }
+
+        bool should_order_before(const NIFTWBackwardDPLabel& label,
+                                 const NIFTWBackwardDPLabel& other) {
+            return label.t_max > other.t_max;
+        }
+
+        std::vector<VertexID> extract_path(const NIFTWBackwardDPLabel& sink_label) {
+            std::vector<VertexID> route;
+            for (const auto* label = &sink_label;; label = label->predecessor) {
+                route.push_back(label->vertex_id);
+                if (label->root_label()) break;
+            }
+            std::reverse(route.begin(), route.end());
+            return route;
+        }
+
+        bool is_final_label(const NIFTWBackwardDPLabel& label) {
+            return label.vertex_id == _instance->Depot().id && !label.root_label();
+        }
+
+        void prepare(const std::vector<VertexID>&) {}
+
+        [[nodiscard]] size_t parameter_hash() const {
+            return std::hash<resource_t>{}(_battery_capacity) * 31
+                   + std::hash<resource_t>{}(_replenishment_time);
+        }
+
+        NIFTWBackwardDPLabel create_root_label() {
+            NIFTWBackwardDPLabel label;
+            label.vertex_id = _instance->Depot().id;
+            label.t_max = _instance->Depot().get_data<NIFTWVertexData>().latest_arrival_time;
+            return label;
+        }
     };
 }  // namespace routingblocks
 
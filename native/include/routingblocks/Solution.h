@@ -112,6 +112,16 @@ namespace routingblocks {
             return _nodes.insert(std::next(pos), begin, end);
         }
 
+        // Updates the labels of a route where only nodes in [first_modified, end_modified) have
+        // changed, i.e., were inserted, replaced or moved. Forward labels before and backward
+        // labels after that range remain valid.
+        void _update_modified(size_t first_modified, size_t end_modified) {
+            assert(first_modified > 0);
+            assert(first_modified <= end_modified);
+            assert(end_modified < _nodes.size());
+            update(std::next(begin(), first_modified - 1), std::next(begin(), end_modified));
+        }
+
         template <class InputIterator>
         void _remove_vertices(InputIterator begin, InputIterator end) {
             if (begin == end) return;
@@ -119,12 +129,18 @@ namespace routingblocks {
             //  A better implementation could base on std::remove, begin->end is sorted in
             //  reverse order.
             //  Sorting in "normal" order would allow efficient partition
-            for (; begin != end; ++begin) {
+            const size_t last_removed_position = begin->position;
+            size_t first_removed_position = last_removed_position;
+            size_t num_removed = 0;
+            for (; begin != end; ++begin, ++num_removed) {
+                first_removed_position = begin->position;
                 _nodes.erase(std::next(
                     this->begin(),
                     begin->position));  // Will not invalidate any iterators that come after begin
             }
-            update();
+            // Successors of the last removed node moved num_removed positions forward
+            _update_modified(first_removed_position,
+                             last_removed_position + 1 - num_removed);
         }
 
         template <class input_iterator_t>
@@ -132,13 +148,18 @@ namespace routingblocks {
             if (locations_begin == locations_end) return;
             // The function assumes that [begin, end) is sorted in reverse order, i.e., largest
             // position first
-            for (; locations_begin != locations_end; ++locations_begin) {
+            const size_t last_predecessor_position = locations_begin->second.position;
+            size_t first_predecessor_position = last_predecessor_position;
+            size_t num_inserted = 0;
+            for (; locations_begin != locations_end; ++locations_begin, ++num_inserted) {
                 auto& [vertex_id, location] = *locations_begin;
                 assert(location.position < _nodes.size() - 1);
+                first_predecessor_position = location.position;
                 _nodes.insert(std::next(this->begin(), location.position + 1),
                               create_node(*_evaluation, *_instance, vertex_id));
             }
-            update();
+            _update_modified(first_predecessor_position + 1,
+                             last_predecessor_position + 1 + num_inserted);
         }
 
       public:
@@ -225,7 +246,8 @@ namespace routingblocks {
 
         iterator remove_segment(const_iterator begin, const_iterator end) {
             auto past_erase = _remove_segment(begin, end);
-            update();  // TODO Update only modified segment
+            const auto position = static_cast<size_t>(std::distance(this->begin(), past_erase));
+            _update_modified(position, position);
             return past_erase;
         }
 
@@ -271,8 +293,11 @@ namespace routingblocks {
         template <class InputIterator>
             requires NodeIterator<InputIterator>
         iterator insert_segment_after(const_iterator pos, InputIterator begin, InputIterator end) {
+            const auto num_inserted = static_cast<size_t>(std::distance(begin, end));
             auto first_inserted_element = _insert_segment_after(pos, begin, end);
-            update();  // TODO Update only modified segment
+            const auto position
+                = static_cast<size_t>(std::distance(this->begin(), first_inserted_element));
+            _update_modified(position, position + num_inserted);
             return first_inserted_element;
         }
 
@@ -287,14 +312,20 @@ namespace routingblocks {
                 return other.exchange_segments(other_begin, other_end, begin, end, *this);
             }
             // [begin, end) is the shortest of both ranges
+            const auto position = static_cast<size_t>(std::distance(this->begin(), begin));
+            const auto other_position
+                = static_cast<size_t>(std::distance(other.begin(), other_begin));
+            const auto segment_length = static_cast<size_t>(std::distance(begin, end));
+            const auto other_segment_length
+                = static_cast<size_t>(std::distance(other_begin, other_end));
             auto other_first_unchanged = std::swap_ranges(begin, end, other_begin);
             // Insert [other_first_unchanged, other_end) before end
             _insert_segment_after(std::prev(end), other_first_unchanged, other_end);
             // Remove [other_first_unchanged, other_end) from other
             other._remove_segment(other_first_unchanged, other_end);
-            // Finally update both routes
-            update();
-            other.update();
+            // Finally update both routes. Only the exchanged segments have changed.
+            _update_modified(position, position + other_segment_length);
+            other._update_modified(other_position, other_position + segment_length);
         }
 
         void exchange_segments(iterator begin, iterator end, iterator other_begin,
@@ -305,6 +336,11 @@ namespace routingblocks {
             if (std::distance(begin, end) > std::distance(other_begin, other_end)) {
                 return exchange_segments(other_begin, other_end, begin, end);
             }
+            // Nodes outside of the span of both segments keep their position
+            const auto first_modified
+                = static_cast<size_t>(std::distance(this->begin(), std::min(begin, other_begin)));
+            const auto end_modified
+                = static_cast<size_t>(std::distance(this->begin(), std::max(end, other_end)));
             // We cannot rely on swap_ranges here because the ranges might overlap
             // Hand rolled implementation of iter swap.
             for (; begin != end; ++begin, ++other_begin) {
@@ -321,7 +357,7 @@ namespace routingblocks {
                 std::rotate(end, other_begin, other_end);
             }
             // Finally update the route
-            update();
+            _update_modified(first_modified, end_modified);
         }
 
         // Update nodes
@@ -337,9 +373,9 @@ namespace routingblocks {
             auto next_backward = first_valid_backward;
             for (--next_backward; first_valid_backward != begin();
                  first_valid_backward = next_backward--) {
-                next_backward->update_backward(*_evaluation, *first_valid_backward,
-                                               _instance->getArc(first_valid_backward->vertex_id(),
-                                                                 next_backward->vertex_id()));
+                const auto& arc = _instance->getArc(next_backward->vertex_id(),
+                                                    first_valid_backward->vertex_id());
+                next_backward->update_backward(*_evaluation, *first_valid_backward, arc);
             }
             _modification_timestamp = _next_modification_timestamp++;
         }
@@ -413,7 +449,10 @@ namespace routingblocks {
         const Instance* _instance;
         std::shared_ptr<eval_t> _evaluation;
 
-        void _update_vertex_lookup(unsigned int route_index);
+        // Removes the lookup entries of nodes at positions [first_position, end) of the route.
+        void _unregister_nodes(size_t route_index, size_t first_position = 0);
+        // Adds lookup entries for nodes at positions [first_position, end) of the route.
+        void _register_nodes(size_t route_index, size_t first_position = 0);
 
         void _update_vertex_lookup();
 
@@ -426,11 +465,15 @@ namespace routingblocks {
                     last_route_pos_begin, end, [last_route_pos_begin](const auto& location) {
                         return location.route != last_route_pos_begin->route;
                     });
-                auto next_route = std::next(this->begin(), last_route_pos_begin->route);
-                next_route->remove_vertices(last_route_pos_begin, last_route_pos_end);
+                // Sorted in reverse order, the last location has the smallest position
+                const size_t route_index = last_route_pos_begin->route;
+                const size_t first_position = std::prev(last_route_pos_end)->position;
+                _unregister_nodes(route_index, first_position);
+                std::next(this->begin(), route_index)
+                    ->remove_vertices(last_route_pos_begin, last_route_pos_end);
+                _register_nodes(route_index, first_position);
                 last_route_pos_begin = last_route_pos_end;
             }
-            _update_vertex_lookup();
         }
 
         template <class input_iterator_t>
@@ -447,11 +490,14 @@ namespace routingblocks {
                                        return vertex_and_location.second.route
                                               != last_route_pos_begin->second.route;
                                    });
-                auto next_route = std::next(this->begin(), last_route_pos_begin->second.route);
-                next_route->insert_vertices_after(last_route_pos_begin, last_route_pos_end);
+                const size_t route_index = last_route_pos_begin->second.route;
+                const size_t first_position = std::prev(last_route_pos_end)->second.position + 1;
+                _unregister_nodes(route_index, first_position);
+                std::next(this->begin(), route_index)
+                    ->insert_vertices_after(last_route_pos_begin, last_route_pos_end);
+                _register_nodes(route_index, first_position);
                 last_route_pos_begin = last_route_pos_end;
             }
-            _update_vertex_lookup();
         }
 
       public:
@@ -573,19 +619,26 @@ namespace routingblocks {
         }
 
         void remove_route(const_iterator route) {
+            // Routes after the removed one shift their index
+            const auto route_index = static_cast<size_t>(std::distance(cbegin(), route));
+            for (size_t i = route_index; i < _routes.size(); ++i) {
+                _unregister_nodes(i);
+            }
             _routes.erase(route);
-            _update_vertex_lookup();
+            for (size_t i = route_index; i < _routes.size(); ++i) {
+                _register_nodes(i);
+            }
         }
 
         const_iterator add_route() {
             _routes.emplace_back(_evaluation, *_instance);
-            _update_vertex_lookup(_routes.size() - 1);
+            _register_nodes(_routes.size() - 1);
             return std::prev(_routes.end());
         }
 
         const_iterator add_route(Route route) {
             _routes.push_back(std::move(route));
-            _update_vertex_lookup(_routes.size() - 1);
+            _register_nodes(_routes.size() - 1);
             return std::prev(_routes.end());
         }
     };
@@ -625,6 +678,21 @@ namespace routingblocks {
         return evaluation.evaluate(instance, storage);
     }
 
+    /**
+     * Statically dispatched overload for evaluations with known label types, e.g.,
+     * ADPTWEvaluation. Avoids virtual calls and type erasure.
+     */
+    template <class evaluation_t, std::same_as<route_segment>... Segments>
+        requires requires(evaluation_t& evaluation, const Instance& instance,
+                          std::span<const route_segment> segments) {
+            evaluation.evaluate_segments(instance, segments);
+        }
+    cost_t concatenate(evaluation_t& evaluation, const Instance& instance, Segments&&... params) {
+        const std::array<const route_segment, sizeof...(params)> storage{
+            std::forward<Segments>(params)...};
+        return evaluation.evaluate_segments(instance, storage);
+    }
+
     template <class node_iterator_t>
         requires NodeIterator<node_iterator_t>
     inline cost_t evaluate_insertion(Evaluation& evaluation, const Instance& instance,
@@ -0,0 +1,284 @@
+/*
+ * Copyright (c) 2023 Patrick S. Klein (@libklein)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef routingblocks_TYPEDROUTE_H
+#define routingblocks_TYPEDROUTE_H
+
+#include <routingblocks/Instance.h>
+#include <routingblocks/Solution.h>
+#include <routingblocks/evaluation.h>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <concepts>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace routingblocks {
+
+    template <class evaluation_t>
+    concept typed_concatenation_evaluation = requires {
+        typename evaluation_t::fwd_label_t;
+        typename evaluation_t::bwd_label_t;
+        typename evaluation_t::vertex_data_t;
+        typename evaluation_t::arc_data_t;
+    } && std::derived_from<evaluation_t, ConcatenationBasedEvaluation>;
+
+    /**
+     * Route storage for evaluations with known label types, e.g., ADPTWEvaluation or
+     * NIFTWEvaluation. Keeps vertex ids, vertex data, forward and backward labels in separate
+     * contiguous arrays (structure of arrays) and calls the evaluation without virtual dispatch
+     * or type erasure. Labels are kept consistent with the route's vertex sequence in the same way
+     * Route does, i.e., forward labels at position i describe the sequence [0, i], backward labels
+     * the sequence [i, size()).
+     */
+    template <typed_concatenation_evaluation evaluation_t> class TypedRoute {
+      public:
+        using fwd_label_t = typename evaluation_t::fwd_label_t;
+        using bwd_label_t = typename evaluation_t::bwd_label_t;
+        using vertex_data_t = typename evaluation_t::vertex_data_t;
+        using arc_data_t = typename evaluation_t::arc_data_t;
+
+      private:
+        const Instance* _instance;
+        std::shared_ptr<evaluation_t> _evaluation;
+        // Position i of each array describes the i-th visit of the route
+        std::vector<VertexID> _vertex_ids;
+        std::vector<const vertex_data_t*> _vertex_data;
+        std::vector<fwd_label_t> _forward_labels;
+        std::vector<bwd_label_t> _backward_labels;
+
+        [[nodiscard]] const Vertex& _vertex(size_t position) const {
+            return _instance->getVertex(_vertex_ids[position]);
+        }
+
+        [[nodiscard]] fwd_label_t _propagate_forward(const fwd_label_t& pred_label,
+                                                     VertexID pred_vertex_id,
+                                                     const vertex_data_t& pred_vertex_data,
+                                                     VertexID vertex_id,
+                                                     const vertex_data_t& vertex_data) const {
+            const auto& arc = _instance->getArc(pred_vertex_id, vertex_id);
+            return _evaluation->propagate_forward(
+                pred_label, _instance->getVertex(pred_vertex_id), pred_vertex_data,
+                _instance->getVertex(vertex_id), vertex_data, arc, arc.get_data<arc_data_t>());
+        }
+
+        [[nodiscard]] bwd_label_t _propagate_backward(const bwd_label_t& succ_label,
+                                                      VertexID succ_vertex_id,
+                                                      const vertex_data_t& succ_vertex_data,
+                                                      VertexID vertex_id,
+                                                      const vertex_data_t& vertex_data) const {
+            const auto& arc = _instance->getArc(vertex_id, succ_vertex_id);
+            return _evaluation->propagate_backward(
+                succ_label, _instance->getVertex(succ_vertex_id), succ_vertex_data,
+                _instance->getVertex(vertex_id), vertex_data, arc, arc.get_data<arc_data_t>());
+        }
+
+        // Appends a visit to the given vertex without updating labels
+        void _push_back(VertexID vertex_id) {
+            const auto& vertex = _instance->getVertex(vertex_id);
+            const auto& vertex_data = vertex.get_data<vertex_data_t>();
+            _vertex_ids.push_back(vertex_id);
+            _vertex_data.push_back(&vertex_data);
+            _forward_labels.push_back(_evaluation->create_forward_label(vertex, vertex_data));
+            _backward_labels.push_back(_evaluation->create_backward_label(vertex, vertex_data));
+        }
+
+        template <class InputIterator> void _assign(InputIterator begin, InputIterator end) {
+            const auto& depot = _instance->Depot();
+            _vertex_ids.clear();
+            _vertex_data.clear();
+            _forward_labels.clear();
+            _backward_labels.clear();
+            _push_back(depot.id);
+            for (; begin != end; ++begin) {
+                _push_back(*begin);
+            }
+            _push_back(depot.id);
+            update();
+        }
+
+      public:
+        TypedRoute(std::shared_ptr<evaluation_t> evaluation, const Instance& instance)
+            : _instance(&instance), _evaluation(std::move(evaluation)) {
+            std::array<VertexID, 0> no_vertices{};
+            _assign(no_vertices.begin(), no_vertices.end());
+        }
+
+        template <class InputIterator>
+            requires VertexIDIterator<InputIterator>
+        TypedRoute(std::shared_ptr<evaluation_t> evaluation, const Instance& instance,
+                   InputIterator begin, InputIterator end)
+            : _instance(&instance), _evaluation(std::move(evaluation)) {
+            _assign(begin, end);
+        }
+
+        /**
+         * Creates a typed copy of the given route. Labels are recomputed using the passed
+         * evaluation.
+         */
+        TypedRoute(std::shared_ptr<evaluation_t> evaluation, const Instance& instance,
+                   const Route& route)
+            : _instance(&instance), _evaluation(std::move(evaluation)) {
+            std::vector<VertexID> vertex_ids;
+            vertex_ids.reserve(route.size() - 2);
+            std::transform(std::next(route.begin()), route.end_depot(),
+                           std::back_inserter(vertex_ids),
+                           [](const Node& node) { return node.vertex_id(); });
+            _assign(vertex_ids.begin(), vertex_ids.end());
+        }
+
+        [[nodiscard]] size_t size() const noexcept { return _vertex_ids.size(); }
+        [[nodiscard]] bool empty() const noexcept { return _vertex_ids.size() == 2; }
+
+        [[nodiscard]] VertexID vertex_id(size_t position) const { return _vertex_ids[position]; }
+        [[nodiscard]] std::span<const VertexID> vertex_ids() const { return _vertex_ids; }
+        [[nodiscard]] const fwd_label_t& forward_label(size_t position) const {
+            return _forward_labels[position];
+        }
+        [[nodiscard]] const bwd_label_t& backward_label(size_t position) const {
+            return _backward_labels[position];
+        }
+
+        [[nodiscard]] cost_t cost() const {
+            return _evaluation->compute_cost(_forward_labels.back());
+        }
+        [[nodiscard]] std::vector<resource_t> cost_components() const {
+            return _evaluation->get_cost_components(_forward_labels.back());
+        }
+        [[nodiscard]] bool feasible() const {
+            return _evaluation->is_feasible(_forward_labels.back());
+        }
+
+        /**
+         * Converts this route to a regular (type-erased) route.
+         */
+        [[nodiscard]] Route to_route() const {
+            return Route(_evaluation, *_instance, std::next(_vertex_ids.begin()),
+                         std::prev(_vertex_ids.end()));
+        }
+
+        /**
+         * Updates all labels.
+         */
+        void update() { update(1, size() - 1); }
+
+        /**
+         * Updates labels of a route where only visits in [first_modified, end_modified) have
+         * changed. Forward labels before and backward labels after that range remain valid.
+         */
+        void update(size_t first_modified, size_t end_modified) {
+            assert(first_modified > 0);
+            assert(first_modified <= end_modified);
+            assert(end_modified < size());
+            for (size_t i = first_modified; i < size(); ++i) {
+                _forward_labels[i]
+                    = _propagate_forward(_forward_labels[i - 1], _vertex_ids[i - 1],
+                                         *_vertex_data[i - 1], _vertex_ids[i], *_vertex_data[i]);
+            }
+            for (size_t i = end_modified; i > 0; --i) {
+                _backward_labels[i - 1]
+                    = _propagate_backward(_backward_labels[i], _vertex_ids[i], *_vertex_data[i],
+                                          _vertex_ids[i - 1], *_vertex_data[i - 1]);
+            }
+        }
+
+        /**
+         * Removes the visits at positions [begin, end).
+         */
+        void remove_segment(size_t begin, size_t end) {
+            assert(begin > 0);
+            assert(begin <= end && end < size());
+            _vertex_ids.erase(std::next(_vertex_ids.begin(), begin),
+                              std::next(_vertex_ids.begin(), end));
+            _vertex_data.erase(std::next(_vertex_data.begin(), begin),
+                               std::next(_vertex_data.begin(), end));
+            _forward_labels.erase(std::next(_forward_labels.begin(), begin),
+                                  std::next(_forward_labels.begin(), end));
+            _backward_labels.erase(std::next(_backward_labels.begin(), begin),
+                                   std::next(_backward_labels.begin(), end));
+            update(begin, begin);
+        }
+
+        /**
+         * Inserts visits to the vertices in [begin, end) after the given position.
+         */
+        template <class InputIterator>
+            requires VertexIDIterator<InputIterator>
+        void insert_segment_after(size_t position, InputIterator begin, InputIterator end) {
+            assert(position + 1 < size());
+            std::vector<VertexID> vertex_ids(begin, end);
+            std::vector<const vertex_data_t*> vertex_data;
+            vertex_data.reserve(vertex_ids.size());
+            for (auto id : vertex_ids) {
+                vertex_data.push_back(&_instance->getVertex(id).get_data<vertex_data_t>());
+            }
+            const auto insert_at = position + 1;
+            _vertex_ids.insert(std::next(_vertex_ids.begin(), insert_at), vertex_ids.begin(),
+                               vertex_ids.end());
+            _vertex_data.insert(std::next(_vertex_data.begin(), insert_at), vertex_data.begin(),
+                                vertex_data.end());
+            // Placeholder labels, overwritten by update
+            _forward_labels.insert(std::next(_forward_labels.begin(), insert_at),
+                                   vertex_ids.size(), _forward_labels[position]);
+            _backward_labels.insert(std::next(_backward_labels.begin(), insert_at),
+                                    vertex_ids.size(), _backward_labels[position]);
+            update(insert_at, insert_at + vertex_ids.size());
+        }
+
+        /**
+         * Computes the cost of the route obtained by inserting a visit to vertex_id after the
+         * given position. Does not modify the route.
+         */
+        [[nodiscard]] cost_t evaluate_insertion(size_t position, VertexID vertex_id) const {
+            assert(position + 1 < size());
+            const auto& vertex_data
+                = _instance->getVertex(vertex_id).get_data<vertex_data_t>();
+            const auto fwd = _propagate_forward(_forward_labels[position], _vertex_ids[position],
+                                                *_vertex_data[position], vertex_id, vertex_data);
+            const auto succ_fwd
+                = _propagate_forward(fwd, vertex_id, vertex_data, _vertex_ids[position + 1],
+                                     *_vertex_data[position + 1]);
+            return _evaluation->concatenate(succ_fwd, _backward_labels[position + 1],
+                                            _vertex(position + 1), *_vertex_data[position + 1]);
+        }
+
+        /**
+         * Computes the cost of the route obtained by removing the visits at positions
+         * [begin, end). Does not modify the route.
+         */
+        [[nodiscard]] cost_t evaluate_removal(size_t begin, size_t end) const {
+            assert(begin > 0);
+            assert(begin <= end && end < size());
+            const auto fwd = _propagate_forward(_forward_labels[begin - 1], _vertex_ids[begin - 1],
+                                                *_vertex_data[begin - 1], _vertex_ids[end],
+                                                *_vertex_data[end]);
+            return _evaluation->concatenate(fwd, _backward_labels[end], _vertex(end),
+                                            *_vertex_data[end]);
+        }
+    };
+
+}  // namespace routingblocks
+
+#endif  // routingblocks_TYPEDROUTE_H
@@ -24,6 +24,7 @@
 #define _routingblocks_ARC_H
 
 #include <memory>
+#include <vector>
 
 namespace routingblocks {
     struct Arc {
@@ -36,6 +37,21 @@ namespace routingblocks {
         template <class T> T& get_data() { return *static_cast<T*>(data.get()); }
         template <class T> const T& get_data() const { return *static_cast<const T*>(data.get()); }
     };
+
+    /**
+     * Creates arcs for a row-major arc data matrix. The data of all arcs is stored in a single
+     * contiguous block shared by the returned arcs, which avoids allocating (and reference
+     * counting) one block per arc.
+     */
+    template <class T> std::vector<Arc> make_arc_matrix(std::vector<T> arc_data) {
+        auto storage = std::make_shared<std::vector<T>>(std::move(arc_data));
+        std::vector<Arc> arcs;
+        arcs.reserve(storage->size());
+        for (auto& data : *storage) {
+            arcs.emplace_back(Arc::data_t(storage, &data));
+        }
+        return arcs;
+    }
 }  // namespace routingblocks
 
 #endif  //_routingblocks_ARC_H
@@ -35,6 +35,13 @@
 
 namespace routingblocks {
 
+    /**
+     * Evaluates routes based on labels stored at each node. Multi-threaded components, e.g.,
+     * LocalSearch with number_of_threads > 1, call an evaluation and copy its labels from several
+     * threads at once. Evaluations used this way must not modify shared state; the native ones
+     * do not. Evaluations implemented in Python store Python objects in their labels and are thus
+     * limited to a single thread.
+     */
     class Evaluation {
       public:
         using label_holder_t = Node::label_holder_t;
@@ -69,12 +76,18 @@ namespace routingblocks {
      * Vidal 2014, https://doi.org/10.1016/j.ejor.2013.09.045)
      */
     class ConcatenationBasedEvaluation : public Evaluation {
+      public:
+        /**
+         * Computes the cost of the route formed by joining the forward label of a prefix, which
+         * has been propagated up to the passed vertex, with the backward label of the suffix
+         * starting at that vertex.
+         */
         virtual cost_t concatenate(const label_holder_t& fwd, const label_holder_t& bwd,
                                    const routingblocks::Vertex& vertex)
             = 0;
 
         cost_t evaluate(const Instance& instance,
-                        const std::span<const route_segment> segments) final {
+                        const std::span<const route_segment> segments) override {
             auto next_segment = segments.begin();
             // Last segment with a valid forward label
             auto cur_segment = next_segment++;
@@ -137,6 +150,51 @@ namespace routingblocks {
       public:
         using label_holder_t = detail::label_holder;
 
+        /**
+         * Statically dispatched counterpart of Evaluation::evaluate. Works on the typed labels
+         * directly, which allows the compiler to inline Impl's label algebra when the concrete
+         * evaluation type is known at compile time.
+         */
+        [[nodiscard]] cost_t evaluate_segments(const Instance& instance,
+                                               std::span<const route_segment> segments) {
+            auto next_segment = segments.begin();
+            // Last segment with a valid forward label
+            auto cur_segment = next_segment++;
+            // First segment with a valid bwd label
+            auto last_segment = std::prev(segments.end());
+            // Last node with a valid forward label
+            const Node* pred_node = &cur_segment->back();
+            const vertex_data_t* pred_vertex_data = &pred_node->vertex().get_data<vertex_data_t>();
+            fwd_label_t fwd_label = pred_node->forward_label().get<fwd_label_t>();
+
+            auto propagate_to = [&](const Node& next_node) {
+                const auto& next_vertex_data = next_node.vertex().get_data<vertex_data_t>();
+                const auto& arc = instance.getArc(pred_node->vertex_id(), next_node.vertex_id());
+                fwd_label = get_impl().propagate_forward(
+                    fwd_label, pred_node->vertex(), *pred_vertex_data, next_node.vertex(),
+                    next_vertex_data, arc, arc.get_data<arc_data_t>());
+                pred_node = &next_node;
+                pred_vertex_data = &next_vertex_data;
+            };
+
+            for (; next_segment != last_segment; cur_segment = next_segment++) {
+                for (const Node& next_node : *next_segment) {
+                    propagate_to(next_node);
+                }
+            }
+            // First node with a valid backward label
+            const Node& concatenation_node = next_segment->front();
+            propagate_to(concatenation_node);
+            return get_impl().concatenate(fwd_label,
+                                          concatenation_node.backward_label().get<bwd_label_t>(),
+                                          concatenation_node.vertex(), *pred_vertex_data);
+        }
+
+        [[nodiscard]] cost_t evaluate(const Instance& instance,
+                                      std::span<const route_segment> segments) final {
+            return evaluate_segments(instance, segments);
+        }
+
         [[nodiscard]] cost_t concatenate(const label_holder_t& fwd, const label_holder_t& bwd,
                                          const routingblocks::Vertex& vertex) final {
             return get_impl().concatenate(fwd.get<fwd_label_t>(), bwd.get<bwd_label_t>(), vertex,
@@ -163,9 +221,9 @@ namespace routingblocks {
             const auto& pred_vertex_data = pred_vertex.get_data<vertex_data_t>();
             const auto& vertex_data = vertex.get_data<vertex_data_t>();
             const auto& arc_data = arc.get_data<arc_data_t>();
-            return label_holder_t(std::make_shared<fwd_label_t>(get_impl().propagate_forward(
+            return label_holder_t(std::in_place_type<fwd_label_t>, get_impl().propagate_forward(
                 pred_label.get<fwd_label_t>(), pred_vertex, pred_vertex_data, vertex, vertex_data,
-                arc, arc_data)));
+                arc, arc_data));
         }
 
         [[nodiscard]] label_holder_t propagate_backward(const label_holder_t& succ_label,
@@ -175,21 +233,21 @@ namespace routingblocks {
             const auto& succ_vertex_data = succ_vertex.get_data<vertex_data_t>();
             const auto& vertex_data = vertex.get_data<vertex_data_t>();
             const auto& arc_data = arc.get_data<arc_data_t>();
-            return label_holder_t(std::make_shared<bwd_label_t>(get_impl().propagate_backward(
+            return label_holder_t(std::in_place_type<bwd_label_t>, get_impl().propagate_backward(
                 succ_label.get<bwd_label_t>(), succ_vertex, succ_vertex_data, vertex, vertex_data,
-                arc, arc_data)));
+                arc, arc_data));
         }
 
         [[nodiscard]] label_holder_t create_forward_label(const Vertex& vertex) final {
             const auto& vertex_data = vertex.get_data<vertex_data_t>();
-            return label_holder_t(std::make_shared<fwd_label_t>(
-                get_impl().create_forward_label(vertex, vertex_data)));
+            return label_holder_t(std::in_place_type<fwd_label_t>,
+                                  get_impl().create_forward_label(vertex, vertex_data));
         }
 
         [[nodiscard]] label_holder_t create_backward_label(const Vertex& vertex) final {
             const auto& vertex_data = vertex.get_data<vertex_data_t>();
-            return label_holder_t(std::make_shared<bwd_label_t>(
-                get_impl().create_backward_label(vertex, vertex_data)));
+            return label_holder_t(std::in_place_type<bwd_label_t>,
+                                  get_impl().create_backward_label(vertex, vertex_data));
         }
     };
 
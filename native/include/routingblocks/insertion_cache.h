@@ -27,8 +27,13 @@
 #include <routingblocks/Solution.h>
 #include <routingblocks/evaluation.h>
 #include <routingblocks/types.h>
+#include <routingblocks/utility/thread_pool.h>
+#include <routingblocks/utility/tournament_tree.h>
 
+#include <algorithm>
 #include <dynamic_bitset/dynamic_bitset.hpp>
+#include <iterator>
+#include <memory>
 #include <vector>
 
 namespace routingblocks::utility {
@@ -84,122 +89,216 @@ namespace routingblocks::utility {
         bool operator!=(const bitset_iterator& other) const { return !(*this == other); }
     };
 
-    template <class child_iterator, class Comp = std::less<typename child_iterator::value_type>>
-    class joint_sorted_iterator {
+    template <class Comp = std::less<insertion_move>> class insertion_cache {
       public:
-        using iterator_category = std::forward_iterator_tag;
-        using value_type = typename child_iterator::value_type;
-        using pointer = typename child_iterator::pointer;
-        using difference_type = std::ptrdiff_t;
-        using reference = typename child_iterator::reference;
+        using move_t = insertion_move;
+        class const_iterator;
 
       private:
-        std::vector<std::pair<child_iterator, child_iterator>> _child_iterators;
-        child_iterator _next_cheapest;
-        const Comp* _comp;
-
-        void _remove_exhausted() {
-            while (!_child_iterators.empty()
-                   && _child_iterators.back().first != _child_iterators.back().second) {
-                _child_iterators.pop_back();
+        using bitset_t = sul::dynamic_bitset<>;
+        // Sorted insertion moves of a single vertex into a single route.
+        using block_t = std::vector<move_t>;
+        // Blocks of a single vertex, indexed by route.
+        using cache_t = std::vector<block_t>;
+        using tracked_vertex_iterator = bitset_iterator<bitset_t>;
+
+        const Instance* _instance;
+        Evaluation* _evaluation{};
+        // Move caches, _caches[i][r] contains all possible insertion moves for vertex with id i
+        // into route r, ordered according to _comp. Keeping moves separated by route means that
+        // invalidating a route only requires re-sorting the moves of that route.
+        std::vector<cache_t> _caches;
+        // Vertices to track insertions of. Setting bit at index i indicates that moves for
+        // vertex with id i should be tracked.
+        bitset_t _tracked_vertices;
+        // _route_trees[i] ranks the routes by the best insertion of vertex i into each route.
+        // _vertex_tree ranks the tracked vertices by their best insertion. Both persist across
+        // calls, so invalidating a route replays O(log R + log V) matches per tracked vertex,
+        // and iteration starts from the tree roots instead of collecting every block.
+        std::vector<tournament_tree> _route_trees;
+        tournament_tree _vertex_tree;
+
+        Comp _comp;
+        // Evaluates the moves of different (vertex, route) pairs concurrently. nullptr if the
+        // cache is single-threaded.
+        std::unique_ptr<thread_pool> _thread_pool;
+
+      public:
+        /**
+         * Iterates over insertion moves in the order given by the comparator. Ties are broken by
+         * vertex id, then by route index. Tournament nodes are expanded lazily: a heap holds
+         * the unexpanded nodes and the next move of each block reached so far, keyed by the best
+         * move each leads to. Starting costs O(log V + log R) heap operations; advancing costs
+         * O(log V + log R) amortized over the tournament nodes it expands.
+         */
+        class const_iterator {
+          public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = move_t;
+            using pointer = const move_t*;
+            using difference_type = std::ptrdiff_t;
+            using reference = const move_t&;
+
+          private:
+            enum class entry_kind { vertex_node, route_node, move };
+
+            struct entry {
+                // Best move reachable from this entry
+                const move_t* move;
+                VertexID vertex;
+                size_t route;
+                // Tournament node for vertex_node and route_node, position in the block for move
+                size_t index;
+                entry_kind kind;
+            };
+
+            const insertion_cache* _cache = nullptr;
+            // Heap w.r.t. _after, i.e., _frontier.front() holds the earliest entry.
+            std::vector<entry> _frontier;
+
+            bool _after(const entry& lhs, const entry& rhs) const {
+                if (_cache->_comp(*rhs.move, *lhs.move)) return true;
+                if (_cache->_comp(*lhs.move, *rhs.move)) return false;
+                return lhs.vertex != rhs.vertex ? lhs.vertex > rhs.vertex : lhs.route > rhs.route;
             }
-        }
 
-        void _advance() {
-            ++_next_cheapest;
-            _remove_exhausted();
-            if (_child_iterators.empty()) return;
-            _set_cheapest();
-        }
+            void _push(entry e) {
+                _frontier.push_back(e);
+                std::push_heap(_frontier.begin(), _frontier.end(),
+                               [this](const entry& lhs, const entry& rhs) {
+                                   return _after(lhs, rhs);
+                               });
+            }
 
-        void _set_cheapest() {
-            _next_cheapest = _child_iterators.back().first;
-            for (auto [child_begin, child_end] : _child_iterators) {
-                if (child_begin == child_end) continue;
-                if ((*_comp)(*child_begin, *_next_cheapest)) {
-                    _next_cheapest = child_begin;
-                }
+            entry _pop() {
+                std::pop_heap(_frontier.begin(), _frontier.end(),
+                              [this](const entry& lhs, const entry& rhs) {
+                                  return _after(lhs, rhs);
+                              });
+                entry e = _frontier.back();
+                _frontier.pop_back();
+                return e;
             }
-        }
 
-      public:
-        joint_sorted_iterator(
-            std::vector<std::pair<child_iterator, child_iterator>> child_iterators,
-            const Comp* comp)
-            : _child_iterators(std::move(child_iterators)), _comp(comp) {
-            _remove_exhausted();
-            if (!_child_iterators.empty()) {
-                _set_cheapest();
+            void _push_vertex_node(size_t node) {
+                const auto vertex_id = _cache->_vertex_tree.winner(node);
+                if (vertex_id == tournament_tree::npos) return;
+                const auto route_index = _cache->_route_trees[vertex_id].winner();
+                _push({&_cache->_caches[vertex_id][route_index].front(),
+                       static_cast<VertexID>(vertex_id), route_index, node,
+                       entry_kind::vertex_node});
             }
-        };
 
-        joint_sorted_iterator() : _child_iterators(0), _comp(nullptr){};
+            void _push_route_node(VertexID vertex_id, size_t node) {
+                const auto route_index = _cache->_route_trees[vertex_id].winner(node);
+                if (route_index == tournament_tree::npos) return;
+                _push({&_cache->_caches[vertex_id][route_index].front(), vertex_id, route_index,
+                       node, entry_kind::route_node});
+            }
 
-        joint_sorted_iterator& operator++() {
-            _advance();
-            return *this;
-        }
+            void _push_move(VertexID vertex_id, size_t route_index, size_t position) {
+                const auto& block = _cache->_caches[vertex_id][route_index];
+                if (position >= block.size()) return;
+                _push({&block[position], vertex_id, route_index, position, entry_kind::move});
+            }
 
-        joint_sorted_iterator operator++(int) {
-            joint_sorted_iterator tmp = *this;
-            _advance();
-            return tmp;
-        }
+            // Expands tournament nodes until the earliest entry is a move.
+            void _settle() {
+                while (!_frontier.empty() && _frontier.front().kind != entry_kind::move) {
+                    const entry e = _pop();
+                    if (e.kind == entry_kind::vertex_node) {
+                        if (_cache->_vertex_tree.is_leaf(e.index)) {
+                            _push_route_node(e.vertex, tournament_tree::root());
+                        } else {
+                            _push_vertex_node(2 * e.index);
+                            _push_vertex_node(2 * e.index + 1);
+                        }
+                    } else if (_cache->_route_trees[e.vertex].is_leaf(e.index)) {
+                        _push_move(e.vertex, e.route, 0);
+                    } else {
+                        _push_route_node(e.vertex, 2 * e.index);
+                        _push_route_node(e.vertex, 2 * e.index + 1);
+                    }
+                }
+            }
 
-        reference operator*() const { return *_next_cheapest; }
+            void _advance() {
+                const entry e = _pop();
+                _push_move(e.vertex, e.route, e.index + 1);
+                _settle();
+            }
 
-        pointer operator->() const { return &*_next_cheapest; }
+          public:
+            const_iterator() = default;
 
-        bool operator==(const joint_sorted_iterator& other) const {
-            if (_child_iterators.empty() && other._child_iterators.empty()) {
-                return true;
-            } else if (_child_iterators.empty() || other._child_iterators.empty()) {
-                return false;
-            } else {
-                return _next_cheapest == other._next_cheapest;
+            // Iterates over the moves of all tracked vertices.
+            explicit const_iterator(const insertion_cache& cache) : _cache(&cache) {
+                _push_vertex_node(tournament_tree::root());
+                _settle();
             }
-        }
 
-        bool operator!=(const joint_sorted_iterator& other) const { return !(*this == other); }
-    };
+            // Iterates over the moves of a single vertex.
+            const_iterator(const insertion_cache& cache, VertexID vertex_id) : _cache(&cache) {
+                _push_route_node(vertex_id, tournament_tree::root());
+                _settle();
+            }
 
-    template <class Comp = std::less<insertion_move>> class insertion_cache {
-      public:
-        using move_t = insertion_move;
+            const_iterator& operator++() {
+                _advance();
+                return *this;
+            }
 
-      private:
-        using bitset_t = sul::dynamic_bitset<>;
-        using cache_t = std::vector<move_t>;
-        using const_iterator = joint_sorted_iterator<typename cache_t::const_iterator, Comp>;
-        using tracked_vertex_iterator = bitset_iterator<bitset_t>;
+            const_iterator operator++(int) {
+                const_iterator tmp = *this;
+                _advance();
+                return tmp;
+            }
 
-      private:
-        const Instance* _instance;
-        Evaluation* _evaluation{};
-        // Move caches, _caches[i] contains all possible insertion moves for vertex with id i.
-        std::vector<cache_t> _caches;
-        // Vertices to track insertions of. Setting bit at index i indicates that moves for
-        // vertex with id i should be tracked.
-        bitset_t _tracked_vertices;
+            reference operator*() const { return *_frontier.front().move; }
 
-        Comp _comp;
+            pointer operator->() const { return _frontier.front().move; }
 
-      public:
-        explicit insertion_cache(const Instance& instance)
-            : _instance(&instance),
-              _caches(_instance->NumberOfVertices(), std::vector<move_t>(0)),
-              _tracked_vertices(_instance->NumberOfVertices()),
-              _comp(){};
+            bool operator==(const const_iterator& other) const {
+                if (_frontier.empty() || other._frontier.empty()) {
+                    return _frontier.empty() && other._frontier.empty();
+                }
+                return _frontier.front().move == other._frontier.front().move;
+            }
+
+            bool operator!=(const const_iterator& other) const { return !(*this == other); }
+        };
+
+        explicit insertion_cache(const Instance& instance, size_t number_of_threads = 1)
+            : insertion_cache(instance, Comp(), number_of_threads){};
 
-        explicit insertion_cache(const Instance& instance, Comp comp)
+        /**
+         * Creates an insertion cache. With number_of_threads > 1, rebuild and invalidate_route
+         * evaluate insertions into different routes and of different vertices concurrently. See
+         * Evaluation for the resulting requirements on the evaluation passed to rebuild.
+         */
+        insertion_cache(const Instance& instance, Comp comp, size_t number_of_threads = 1)
             : _instance(&instance),
-              _caches(_instance->NumberOfVertices(), std::vector<move_t>(0)),
+              _caches(_instance->NumberOfVertices()),
               _tracked_vertices(_instance->NumberOfVertices()),
-              _comp(std::move(comp)){};
+              _route_trees(_instance->NumberOfVertices()),
+              _vertex_tree(_instance->NumberOfVertices()),
+              _comp(std::move(comp)),
+              _thread_pool(number_of_threads > 1 ? std::make_unique<thread_pool>(number_of_threads)
+                                                 : nullptr){};
+
+        [[nodiscard]] size_t number_of_threads() const {
+            return _thread_pool ? _thread_pool->size() : 1;
+        }
 
         void clear() {
             _tracked_vertices.reset();
-            std::for_each(_caches.begin(), _caches.end(), [](auto& cache) { cache.clear(); });
+            // Clear blocks rather than dropping them to retain their capacity
+            for (auto& cache : _caches) {
+                for (auto& block : cache) {
+                    block.clear();
+                }
+            }
+            _vertex_tree.reset(_caches.size());
             _evaluation = nullptr;
         };
 
@@ -209,41 +308,80 @@ namespace routingblocks::utility {
                      InputIterator tracked_vertices_begin, InputIterator tracked_vertices_end) {
             clear();
             _evaluation = &evaluation;
-            auto number_of_insertion_positions = number_of_nodes(solution, true);
-            // Build the initial cache
+            std::vector<VertexID> vertices;
             for (; tracked_vertices_begin != tracked_vertices_end; ++tracked_vertices_begin) {
-                _caches[*tracked_vertices_begin].resize(number_of_insertion_positions);
-                size_t route_index = 0;
-                for (auto route = solution.begin(); route != solution.end();
-                     ++route, ++route_index) {
-                    _update_moves_of_route(*route, route_index, _caches[*tracked_vertices_begin],
-                                           *tracked_vertices_begin);
-                }
-                _restore_order(*tracked_vertices_begin);
+                _caches[*tracked_vertices_begin].resize(solution.size());
                 _tracked_vertices.set(*tracked_vertices_begin);
+                vertices.push_back(*tracked_vertices_begin);
+            }
+            std::vector<const Route*> routes;
+            routes.reserve(solution.size());
+            for (const auto& route : solution) {
+                routes.push_back(&route);
             }
+            // Build the initial cache. Each (vertex, route) pair fills a distinct block.
+            _for_each_block(vertices.size() * routes.size(), [&](size_t block_index) {
+                const VertexID vertex_id = vertices[block_index / routes.size()];
+                const size_t route_index = block_index % routes.size();
+                _update_moves_of_route(*routes[route_index], route_index,
+                                       _caches[vertex_id][route_index], vertex_id);
+            });
+            _tracked_vertices.iterate_bits_on([&](VertexID vertex_id) {
+                _rebuild_route_tree(vertex_id);
+                _vertex_tree.set(vertex_id, _has_moves(vertex_id));
+            });
+            _vertex_tree.replay(_vertex_beats());
         }
 
         void invalidate_route(const Route& route, size_t route_index) {
-            // Update moves involving the invalidated route for each tracked vertex
+            std::vector<VertexID> vertices;
+            vertices.reserve(_tracked_vertices.count());
             _tracked_vertices.iterate_bits_on([&](VertexID vertex_id) {
-                _update_moves_of_route(route, route_index, _caches[vertex_id], vertex_id);
-                _restore_order(vertex_id);
+                auto& cache = _caches[vertex_id];
+                if (route_index >= cache.size()) {
+                    cache.resize(route_index + 1);
+                }
+                vertices.push_back(vertex_id);
+            });
+            // Update moves involving the invalidated route for each tracked vertex. Route trees
+            // are distinct per vertex, so they are updated concurrently as well.
+            _for_each_block(vertices.size(), [&](size_t i) {
+                _update_moves_of_route(route, route_index, _caches[vertices[i]][route_index],
+                                       vertices[i]);
+                _update_route_tree(vertices[i], route_index);
             });
+            for (VertexID vertex_id : vertices) {
+                _vertex_tree.update(vertex_id, _has_moves(vertex_id), _vertex_beats());
+            }
         }
 
-        void stop_tracking(VertexID vertex_id) { _tracked_vertices.reset(vertex_id); }
+        void stop_tracking(VertexID vertex_id) {
+            _tracked_vertices.reset(vertex_id);
+            _vertex_tree.update(vertex_id, false, _vertex_beats());
+        }
 
-        [[nodiscard]] auto best_insertions_for_vertex_begin(VertexID vertex_id) const {
+        [[nodiscard]] const_iterator best_insertions_for_vertex_begin(VertexID vertex_id) const {
             assert(_tracked_vertices.test(vertex_id));
-            assert(!_caches[vertex_id].empty());
-            return _caches[vertex_id].begin();
+            return const_iterator(*this, vertex_id);
         }
 
-        [[nodiscard]] auto best_insertions_for_vertex_end(VertexID vertex_id) const {
+        [[nodiscard]] const_iterator best_insertions_for_vertex_end(VertexID vertex_id) const {
             assert(_tracked_vertices.test(vertex_id));
-            assert(!_caches[vertex_id].empty());
-            return _caches[vertex_id].end();
+            return {};
+        }
+
+        /**
+         * Returns the best insertion of the vertex into the route with the passed index, or
+         * nullptr if the cache holds no insertion into that route.
+         */
+        [[nodiscard]] const move_t* best_insertion_into_route(VertexID vertex_id,
+                                                              size_t route_index) const {
+            assert(_tracked_vertices.test(vertex_id));
+            const auto& cache = _caches[vertex_id];
+            if (route_index >= cache.size() || cache[route_index].empty()) {
+                return nullptr;
+            }
+            return &cache[route_index].front();
         }
 
         [[nodiscard]] tracked_vertex_iterator tracked_vertices_begin() const {
@@ -251,61 +389,80 @@ namespace routingblocks::utility {
         }
         [[nodiscard]] tracked_vertex_iterator tracked_vertices_end() const { return {}; }
 
-        [[nodiscard]] const_iterator begin() const {
-            std::vector<std::pair<cache_t::const_iterator, cache_t::const_iterator>> iters;
-            iters.reserve(_tracked_vertices.count());
-            for (const auto& cache : _caches) {
-                if (cache.empty()) continue;
-                iters.push_back(std::make_pair(cache.begin(), cache.end()));
-            }
-            return {std::move(iters), &_comp};
-        };
+        [[nodiscard]] const_iterator begin() const { return const_iterator(*this); };
         [[nodiscard]] const_iterator end() const { return {}; };
 
         bool tracks(VertexID vertex_id) const { return _tracked_vertices.test(vertex_id); }
 
       private:
-        void _restore_order(VertexID vertex) {
-            std::sort(_caches[vertex].begin(), _caches[vertex].end(), _comp);
+        template <class Task> void _for_each_block(size_t number_of_blocks, Task&& task) {
+            if (_thread_pool) {
+                _thread_pool->parallel_for(number_of_blocks, std::forward<Task>(task));
+            } else {
+                for (size_t i = 0; i < number_of_blocks; ++i) {
+                    task(i);
+                }
+            }
+        }
+
+        [[nodiscard]] bool _has_moves(VertexID vertex_id) const {
+            return _route_trees[vertex_id].winner() != tournament_tree::npos;
+        }
+
+        [[nodiscard]] const move_t& _best_move(VertexID vertex_id) const {
+            return _caches[vertex_id][_route_trees[vertex_id].winner()].front();
+        }
+
+        [[nodiscard]] auto _route_beats(VertexID vertex_id) const {
+            return [this, &cache = _caches[vertex_id]](size_t lhs, size_t rhs) {
+                return _comp(cache[lhs].front(), cache[rhs].front());
+            };
         }
 
-        auto _overwrite_sequence_with_moves_from_route(std::vector<move_t>::iterator seq_begin,
-                                                       const routingblocks::Route& route,
-                                                       size_t route_index, VertexID vertex_id) {
+        [[nodiscard]] auto _vertex_beats() const {
+            return [this](size_t lhs, size_t rhs) {
+                return _comp(_best_move(static_cast<VertexID>(lhs)),
+                             _best_move(static_cast<VertexID>(rhs)));
+            };
+        }
+
+        void _rebuild_route_tree(VertexID vertex_id) {
+            const auto& cache = _caches[vertex_id];
+            auto& tree = _route_trees[vertex_id];
+            tree.reset(cache.size());
+            for (size_t route_index = 0; route_index < cache.size(); ++route_index) {
+                tree.set(route_index, !cache[route_index].empty());
+            }
+            tree.replay(_route_beats(vertex_id));
+        }
+
+        void _update_route_tree(VertexID vertex_id, size_t route_index) {
+            auto& tree = _route_trees[vertex_id];
+            // Routes past the capacity of the tree require a larger tree
+            if (route_index >= tree.capacity()) {
+                _rebuild_route_tree(vertex_id);
+                return;
+            }
+            tree.update(route_index, !_caches[vertex_id][route_index].empty(),
+                        _route_beats(vertex_id));
+        }
+
+        void _update_moves_of_route(const routingblocks::Route& route, size_t route_index,
+                                    block_t& block, VertexID vertex_id) {
+            block.clear();
+            block.reserve(route.size() - 1);
             auto succ = route.begin();
             auto pred = succ++;
             size_t pos = 0;
             auto route_cost = route.cost();
             Node n = create_node(*_evaluation, *_instance, vertex_id);
-            for (; succ != route.end(); ++succ, ++pred, ++pos, ++seq_begin) {
+            for (; succ != route.end(); ++succ, ++pred, ++pos) {
                 cost_t insertion_cost
                     = evaluate_insertion(*_evaluation, *_instance, route, pred, n);
-                *seq_begin = move_t{vertex_id, routingblocks::NodeLocation(route_index, pos),
-                                    insertion_cost - route_cost};
+                block.push_back(move_t{vertex_id, routingblocks::NodeLocation(route_index, pos),
+                                       insertion_cost - route_cost});
             }
-            return seq_begin;
-        }
-
-        void _update_moves_of_route(const routingblocks::Route& route, size_t route_index,
-                                    auto& cache, VertexID vertex_id) {
-            // Partitions the vector into [route_i, route_j, ..., route_index...]
-            auto first_invalid_move = std::partition(
-                cache.begin(), cache.end(),
-                [route_index](const move_t& move) { return move.after_node.route != route_index; });
-            const size_t first_invalid_move_index
-                = std::distance(cache.begin(), first_invalid_move);
-            // Resize the cache to have space for all elements
-            const long prev_route_size = (cache.size() - first_invalid_move_index);
-            // Could be negative if the route grew.
-            const long route_shrank_by = prev_route_size - (route.size() - 1);
-            assert(route_shrank_by <= static_cast<long long>(cache.size()));
-            cache.resize(static_cast<size_t>(cache.size() - route_shrank_by));
-            // Iterator may have been invalidated
-            first_invalid_move = std::next(cache.begin(), first_invalid_move_index);
-            // Now just replace
-            auto cache_end = _overwrite_sequence_with_moves_from_route(first_invalid_move, route,
-                                                                       route_index, vertex_id);
-            assert(cache_end == cache.end());
+            std::sort(block.begin(), block.end(), _comp);
         }
     };
 }  // namespace routingblocks::utility
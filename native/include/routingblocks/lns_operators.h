@@ -23,10 +23,18 @@
 #ifndef routingblocks_LNS_OPERATORS_H
 #define routingblocks_LNS_OPERATORS_H
 
+#include <routingblocks/Instance.h>
 #include <routingblocks/Solution.h>
+#include <routingblocks/insertion_cache.h>
 #include <routingblocks/operators.h>
+#include <routingblocks/relatedness_matrix.h>
+#include <routingblocks/removal_cache.h>
 #include <routingblocks/utility/random.h>
 
+#include <functional>
+#include <memory>
+#include <optional>
+
 namespace routingblocks::lns::operators {
     /**
      * Randomly samples k random positions from the solution without replacement.
@@ -52,6 +60,290 @@ namespace routingblocks::lns::operators {
                                                    size_t numberOfRemovedCustomers) override;
         [[nodiscard]] std::string_view name() const override;
         [[nodiscard]] bool can_apply_to(const routingblocks::Solution& sol) const override;
+        [[nodiscard]] std::shared_ptr<routingblocks::destroy_operator> clone() const override;
+        void reseed(routingblocks::utility::random& random) override;
+    };
+
+    /**
+     * Selects a move from a sequence of moves. Native counterpart of the python move selectors in
+     * routingblocks.operators.move_selectors. Operates on indices, i.e., never sees the moves
+     * themselves, so the same selector can pick from any sequence.
+     */
+    class MoveSelector {
+      public:
+        /**
+         * Returns the index of the selected move in a sequence of number_of_moves > 0 moves.
+         */
+        virtual size_t select(size_t number_of_moves) = 0;
+
+        /**
+         * Returns an independent copy of the selector, including its random state.
+         */
+        [[nodiscard]] virtual std::unique_ptr<MoveSelector> clone() const = 0;
+
+        /**
+         * Draws a fresh seed for the random number generator of the selector, if any.
+         */
+        virtual void reseed([[maybe_unused]] routingblocks::utility::random& random) {}
+
+        virtual ~MoveSelector() = default;
+    };
+
+    class FirstMoveSelector : public MoveSelector {
+      public:
+        size_t select(size_t number_of_moves) override;
+        [[nodiscard]] std::unique_ptr<MoveSelector> clone() const override;
+    };
+
+    class LastMoveSelector : public MoveSelector {
+      public:
+        size_t select(size_t number_of_moves) override;
+        [[nodiscard]] std::unique_ptr<MoveSelector> clone() const override;
+    };
+
+    /**
+     * Selects the n-th (1-based) move, or the last move if there are fewer than n moves.
+     */
+    class NthMoveSelector : public MoveSelector {
+        size_t _n;
+
+      public:
+        explicit NthMoveSelector(size_t n);
+        size_t select(size_t number_of_moves) override;
+        [[nodiscard]] std::unique_ptr<MoveSelector> clone() const override;
+    };
+
+    /**
+     * Skips each move with probability blink_probability and selects the first move that is not
+     * skipped. Selects the last move if all moves are skipped.
+     */
+    class BlinkMoveSelector : public MoveSelector {
+        double _blink_probability;
+        routingblocks::utility::random _random;
+
+      public:
+        BlinkMoveSelector(double blink_probability, routingblocks::utility::random random);
+        size_t select(size_t number_of_moves) override;
+        [[nodiscard]] std::unique_ptr<MoveSelector> clone() const override;
+        void reseed(routingblocks::utility::random& random) override;
+    };
+
+    class RandomMoveSelector : public MoveSelector {
+        routingblocks::utility::random _random;
+
+      public:
+        explicit RandomMoveSelector(routingblocks::utility::random random)
+            : _random(std::move(random)) {}
+        size_t select(size_t number_of_moves) override;
+        [[nodiscard]] std::unique_ptr<MoveSelector> clone() const override;
+        void reseed(routingblocks::utility::random& random) override;
+    };
+
+    /**
+     * Selects the seed of the next cluster removed by ClusterRemoval.
+     */
+    class SeedSelector {
+      public:
+        /**
+         * Returns the location of the next seed, or an empty optional if there is none.
+         * @param already_selected Locations that have already been selected for removal.
+         */
+        virtual std::optional<routingblocks::NodeLocation> select(
+            routingblocks::Evaluation& evaluation, const routingblocks::Solution& solution,
+            const std::vector<routingblocks::NodeLocation>& already_selected)
+            = 0;
+
+        [[nodiscard]] virtual std::unique_ptr<SeedSelector> clone() const = 0;
+
+        /**
+         * Draws a fresh seed for the random number generator of the selector, if any.
+         */
+        virtual void reseed([[maybe_unused]] routingblocks::utility::random& random) {}
+
+        virtual ~SeedSelector() = default;
+    };
+
+    /**
+     * Picks a random visit to one of the passed stations that has not been selected yet.
+     */
+    class StationSeedSelector : public SeedSelector {
+        std::vector<routingblocks::VertexID> _stations;
+        routingblocks::utility::random _random;
+        std::vector<routingblocks::NodeLocation> _candidates;
+
+      public:
+        StationSeedSelector(std::vector<routingblocks::VertexID> stations,
+                            routingblocks::utility::random random)
+            : _stations(std::move(stations)), _random(std::move(random)) {}
+
+        std::optional<routingblocks::NodeLocation> select(
+            routingblocks::Evaluation& evaluation, const routingblocks::Solution& solution,
+            const std::vector<routingblocks::NodeLocation>& already_selected) override;
+        [[nodiscard]] std::unique_ptr<SeedSelector> clone() const override;
+        void reseed(routingblocks::utility::random& random) override;
+    };
+
+    /**
+     * Selects the members of the cluster around a seed vertex.
+     */
+    class ClusterMemberSelector {
+      public:
+        virtual std::vector<routingblocks::NodeLocation> select(
+            routingblocks::Evaluation& evaluation, const routingblocks::Solution& solution,
+            const routingblocks::NodeLocation& seed)
+            = 0;
+
+        [[nodiscard]] virtual std::unique_ptr<ClusterMemberSelector> clone() const = 0;
+
+        /**
+         * Draws a fresh seed for the random number generator of the selector, if any.
+         */
+        virtual void reseed([[maybe_unused]] routingblocks::utility::random& random) {}
+
+        virtual ~ClusterMemberSelector() = default;
+    };
+
+    /**
+     * Selects all visits to vertices closer to the seed vertex than a radius. The radius is picked
+     * uniformly from [min_radius_factor, max_radius_factor] times the maximum distance between
+     * any two of the considered vertices.
+     */
+    class DistanceBasedClusterMemberSelector : public ClusterMemberSelector {
+        // _distance_list[i] holds (distance, vertex) pairs of all considered vertices, ordered by
+        // their distance to vertex i.
+        std::vector<std::vector<std::pair<resource_t, routingblocks::VertexID>>> _distance_list;
+        resource_t _max_distance = 0;
+        resource_t _min_radius_factor;
+        resource_t _max_radius_factor;
+        routingblocks::utility::random _random;
+
+        [[nodiscard]] resource_t _pick_radius();
+
+      public:
+        /**
+         * @param vertices The vertices that may form clusters.
+         * @param get_distance Distance between two vertices. Called once per pair on construction.
+         */
+        DistanceBasedClusterMemberSelector(
+            const std::vector<routingblocks::VertexID>& vertices,
+            const std::function<resource_t(routingblocks::VertexID, routingblocks::VertexID)>&
+                get_distance,
+            resource_t min_radius_factor, resource_t max_radius_factor,
+            routingblocks::utility::random random);
+
+        std::vector<routingblocks::NodeLocation> select(
+            routingblocks::Evaluation& evaluation, const routingblocks::Solution& solution,
+            const routingblocks::NodeLocation& seed) override;
+        [[nodiscard]] std::unique_ptr<ClusterMemberSelector> clone() const override;
+        void reseed(routingblocks::utility::random& random) override;
+    };
+
+    /**
+     * Removes vertices related to seed vertices. Starts from an initial seed and then repeatedly
+     * picks a seed among the removed vertices and removes up to cluster_size of the remaining
+     * vertices, ordered by their relatedness to the seed in descending order.
+     */
+    class RelatedRemoval : public routingblocks::destroy_operator {
+        const routingblocks::utility::relatedness_matrix* _relatedness_matrix;
+        std::unique_ptr<MoveSelector> _move_selector;
+        std::unique_ptr<MoveSelector> _seed_selector;
+        std::unique_ptr<MoveSelector> _initial_seed_selector;
+        size_t _cluster_size;
+
+        // Scratch buffers, retained between calls to avoid reallocations.
+        std::vector<routingblocks::NodeLocation> _nodes_in_solution;
+        std::vector<routingblocks::VertexID> _vertices_in_solution;
+        std::vector<size_t> _vertex_offsets;
+        std::vector<size_t> _nodes_by_vertex;
+        std::vector<size_t> _candidates;
+
+      public:
+        /**
+         * @param relatedness_matrix Relatedness between vertices. Must outlive the operator.
+         * @param move_selector Selects the next removed vertex among the remaining vertices,
+         * ordered by relatedness to the seed in descending order.
+         * @param seed_selector Selects the next seed among the removed vertices.
+         * @param initial_seed_selector Selects the initial seed among the nodes of the solution.
+         * @param cluster_size Number of vertices removed per seed.
+         */
+        RelatedRemoval(const routingblocks::utility::relatedness_matrix& relatedness_matrix,
+                       const MoveSelector& move_selector, const MoveSelector& seed_selector,
+                       const MoveSelector& initial_seed_selector, size_t cluster_size = 1);
+
+        std::vector<routingblocks::VertexID> apply(routingblocks::Evaluation& evaluation,
+                                                   routingblocks::Solution& sol,
+                                                   size_t numberOfRemovedCustomers) override;
+        [[nodiscard]] std::string_view name() const override;
+        [[nodiscard]] bool can_apply_to(const routingblocks::Solution& sol) const override;
+        [[nodiscard]] std::shared_ptr<routingblocks::destroy_operator> clone() const override;
+        void reseed(routingblocks::utility::random& random) override;
+    };
+
+    /**
+     * Removes vertices one at a time, choosing among the removal moves ordered by cost delta.
+     */
+    class WorstRemoval : public routingblocks::destroy_operator {
+        const routingblocks::Instance* _instance;
+        routingblocks::utility::removal_cache<> _removal_cache;
+        std::unique_ptr<MoveSelector> _move_selector;
+
+      public:
+        WorstRemoval(const routingblocks::Instance& instance, const MoveSelector& move_selector);
+
+        std::vector<routingblocks::VertexID> apply(routingblocks::Evaluation& evaluation,
+                                                   routingblocks::Solution& sol,
+                                                   size_t numberOfRemovedCustomers) override;
+        [[nodiscard]] std::string_view name() const override;
+        [[nodiscard]] bool can_apply_to(const routingblocks::Solution& sol) const override;
+        [[nodiscard]] std::shared_ptr<routingblocks::destroy_operator> clone() const override;
+        void reseed(routingblocks::utility::random& random) override;
+    };
+
+    /**
+     * Removes clusters of vertices. Repeatedly selects a seed and removes the members of the
+     * cluster around it until enough vertices have been selected or no seed is left. Seeds are
+     * only removed if they are members of their cluster.
+     */
+    class ClusterRemoval : public routingblocks::destroy_operator {
+        std::unique_ptr<SeedSelector> _seed_selector;
+        std::unique_ptr<ClusterMemberSelector> _cluster_member_selector;
+
+      public:
+        ClusterRemoval(const SeedSelector& seed_selector,
+                       const ClusterMemberSelector& cluster_member_selector);
+        ClusterRemoval(const ClusterRemoval& other);
+
+        std::vector<routingblocks::VertexID> apply(routingblocks::Evaluation& evaluation,
+                                                   routingblocks::Solution& sol,
+                                                   size_t numberOfRemovedCustomers) override;
+        [[nodiscard]] std::string_view name() const override;
+        [[nodiscard]] bool can_apply_to(const routingblocks::Solution& sol) const override;
+        [[nodiscard]] std::shared_ptr<routingblocks::destroy_operator> clone() const override;
+        void reseed(routingblocks::utility::random& random) override;
+    };
+
+    /**
+     * Cluster removal around random stations. Clusters contain the stations and customers within
+     * a random radius around the seed station.
+     */
+    class StationVicinityRemoval : public routingblocks::destroy_operator {
+        ClusterRemoval _cluster_removal;
+
+      public:
+        StationVicinityRemoval(
+            const routingblocks::Instance& instance,
+            const std::function<resource_t(routingblocks::VertexID, routingblocks::VertexID)>&
+                get_distance,
+            resource_t min_radius_factor, resource_t max_radius_factor,
+            routingblocks::utility::random random);
+
+        std::vector<routingblocks::VertexID> apply(routingblocks::Evaluation& evaluation,
+                                                   routingblocks::Solution& sol,
+                                                   size_t numberOfRemovedCustomers) override;
+        [[nodiscard]] std::string_view name() const override;
+        [[nodiscard]] bool can_apply_to(const routingblocks::Solution& sol) const override;
+        [[nodiscard]] std::shared_ptr<routingblocks::destroy_operator> clone() const override;
+        void reseed(routingblocks::utility::random& random) override;
     };
 
     class RandomInsertion : public routingblocks::repair_operator {
@@ -64,6 +356,81 @@ namespace routingblocks::lns::operators {
                    const std::vector<routingblocks::VertexID>& missing_vertices) override;
         std::string_view name() const override;
         bool can_apply_to(const routingblocks::Solution& sol) const override;
+        std::shared_ptr<routingblocks::repair_operator> clone() const override;
+        void reseed(routingblocks::utility::random& random) override;
+    };
+
+    /**
+     * Inserts vertices one at a time in the passed order. The move selector picks the insertion
+     * position among the positions ordered by cost delta. Stations are not inserted.
+     */
+    class BestInsertion : public routingblocks::repair_operator {
+        const routingblocks::Instance* _instance;
+        routingblocks::utility::insertion_cache<> _insertion_cache;
+        std::unique_ptr<MoveSelector> _move_selector;
+
+        std::vector<routingblocks::VertexID> _missing_vertices;
+
+      public:
+        /**
+         * @param number_of_threads Number of threads used to evaluate insertions, see
+         * utility::insertion_cache.
+         */
+        BestInsertion(const routingblocks::Instance& instance, const MoveSelector& move_selector,
+                      size_t number_of_threads = 1);
+
+        [[nodiscard]] size_t number_of_threads() const {
+            return _insertion_cache.number_of_threads();
+        }
+
+        void apply(routingblocks::Evaluation& evaluation, routingblocks::Solution& sol,
+                   const std::vector<routingblocks::VertexID>& missing_vertices) override;
+        [[nodiscard]] std::string_view name() const override;
+        [[nodiscard]] bool can_apply_to(const routingblocks::Solution& sol) const override;
+        [[nodiscard]] std::shared_ptr<routingblocks::repair_operator> clone() const override;
+        void reseed(routingblocks::utility::random& random) override;
+    };
+
+    /**
+     * Regret-k insertion. Repeatedly ranks the vertices that remain to be inserted by their
+     * regret, i.e., the sum of the differences between the cost of inserting the vertex into its
+     * best route and into its second to k-th best route, in descending order. Ties are broken by
+     * the cost of the best insertion. The vertex selector picks the next vertex from this ranking,
+     * which is then inserted at its best position. k = 1 yields greedy cheapest insertion.
+     * Stations are not inserted.
+     */
+    class RegretInsertion : public routingblocks::repair_operator {
+        struct ranked_vertex {
+            cost_t regret;
+            routingblocks::utility::insertion_move best_insertion;
+            // Index into _missing_vertices
+            size_t index;
+        };
+
+        const routingblocks::Instance* _instance;
+        routingblocks::utility::insertion_cache<> _insertion_cache;
+        size_t _k;
+        std::unique_ptr<MoveSelector> _vertex_selector;
+
+        // Scratch buffers, retained between calls to avoid reallocations.
+        std::vector<routingblocks::VertexID> _missing_vertices;
+        std::vector<const routingblocks::utility::insertion_move*> _route_insertions;
+        std::vector<ranked_vertex> _ranking;
+
+      public:
+        RegretInsertion(const routingblocks::Instance& instance, size_t k,
+                        const MoveSelector& vertex_selector, size_t number_of_threads = 1);
+
+        [[nodiscard]] size_t number_of_threads() const {
+            return _insertion_cache.number_of_threads();
+        }
+
+        void apply(routingblocks::Evaluation& evaluation, routingblocks::Solution& sol,
+                   const std::vector<routingblocks::VertexID>& missing_vertices) override;
+        [[nodiscard]] std::string_view name() const override;
+        [[nodiscard]] bool can_apply_to(const routingblocks::Solution& sol) const override;
+        [[nodiscard]] std::shared_ptr<routingblocks::repair_operator> clone() const override;
+        void reseed(routingblocks::utility::random& random) override;
     };
 }  // namespace routingblocks::lns::operators
 
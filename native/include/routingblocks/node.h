@@ -27,26 +27,158 @@
 #include <routingblocks/types.h>
 #include <routingblocks/vertex.h>
 
+#include <cassert>
 #include <concepts>
+#include <cstddef>
+#include <cstring>
 #include <memory>
+#include <new>
 #include <span>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace routingblocks {
 
     namespace detail {
-        struct label_holder {
-            std::shared_ptr<void> _data;
+        /**
+         * Type-erased label storage. Labels that fit into the inline buffer are stored in place,
+         * which keeps label propagation and node copies free of heap allocations. Larger (or
+         * throwing-move) label types fall back to a heap allocation.
+         */
+        class label_holder {
+          public:
+            // 56 bytes of storage plus the vtable pointer make a holder span one cache line. Large
+            // enough for the built-in ADPTW and NIFTW labels.
+            static constexpr size_t inline_capacity = 56;
+            static constexpr size_t inline_alignment = alignof(void*);
+
+            template <class T> static constexpr bool stores_inline
+                = sizeof(T) <= inline_capacity && alignof(T) <= inline_alignment
+                  && std::is_nothrow_move_constructible_v<T>;
+
+          private:
+            struct vtable_t {
+                // Null function pointers denote trivially copyable/destructible labels.
+                void (*copy)(void* dst, const void* src);
+                void (*move)(void* dst, void* src) noexcept;
+                void (*destroy)(void* data) noexcept;
+            };
+
+            template <class T> static constexpr vtable_t _make_vtable() {
+                if constexpr (!stores_inline<T>) {
+                    // Storage holds a T*
+                    return {[](void* dst, const void* src) {
+                                *static_cast<T**>(dst) = new T(**static_cast<T* const*>(src));
+                            },
+                            [](void* dst, void* src) noexcept {
+                                *static_cast<T**>(dst) = std::exchange(*static_cast<T**>(src),
+                                                                       nullptr);
+                            },
+                            [](void* data) noexcept { delete *static_cast<T**>(data); }};
+                } else if constexpr (std::is_trivially_copyable_v<T>) {
+                    return {nullptr, nullptr, nullptr};
+                } else {
+                    return {[](void* dst, const void* src) {
+                                ::new (dst) T(*static_cast<const T*>(src));
+                            },
+                            [](void* dst, void* src) noexcept {
+                                ::new (dst) T(std::move(*static_cast<T*>(src)));
+                                static_cast<T*>(src)->~T();
+                            },
+                            [](void* data) noexcept { static_cast<T*>(data)->~T(); }};
+                }
+            }
+
+            template <class T> static constexpr vtable_t _vtable = _make_vtable<T>();
+
+            alignas(inline_alignment) std::byte _storage[inline_capacity];
+            const vtable_t* _vtable_ptr = nullptr;
+
+            void _reset() noexcept {
+                if (_vtable_ptr && _vtable_ptr->destroy) {
+                    _vtable_ptr->destroy(_storage);
+                }
+                _vtable_ptr = nullptr;
+            }
+
+            void _copy_from(const label_holder& other) {
+                if (other._vtable_ptr && other._vtable_ptr->copy) {
+                    other._vtable_ptr->copy(_storage, other._storage);
+                } else {
+                    std::memcpy(_storage, other._storage, inline_capacity);
+                }
+                _vtable_ptr = other._vtable_ptr;
+            }
+
+            void _move_from(label_holder& other) noexcept {
+                if (other._vtable_ptr && other._vtable_ptr->move) {
+                    other._vtable_ptr->move(_storage, other._storage);
+                } else {
+                    std::memcpy(_storage, other._storage, inline_capacity);
+                }
+                _vtable_ptr = std::exchange(other._vtable_ptr, nullptr);
+            }
+
+          public:
+            label_holder() noexcept = default;
+
+            template <class T, class... Args>
+            explicit label_holder(std::in_place_type_t<T>, Args&&... args)
+                : _vtable_ptr(&_vtable<T>) {
+                if constexpr (stores_inline<T>) {
+                    ::new (static_cast<void*>(_storage)) T(std::forward<Args>(args)...);
+                } else {
+                    *reinterpret_cast<T**>(_storage) = new T(std::forward<Args>(args)...);
+                }
+            }
+
+            label_holder(const label_holder& other) { _copy_from(other); }
+            label_holder(label_holder&& other) noexcept { _move_from(other); }
+
+            label_holder& operator=(const label_holder& other) {
+                if (this != &other) {
+                    _reset();
+                    _copy_from(other);
+                }
+                return *this;
+            }
+
+            label_holder& operator=(label_holder&& other) noexcept {
+                if (this != &other) {
+                    _reset();
+                    _move_from(other);
+                }
+                return *this;
+            }
+
+            ~label_holder() { _reset(); }
 
-            label_holder(std::shared_ptr<void> data) : _data(std::move(data)){};
+            [[nodiscard]] bool has_value() const noexcept { return _vtable_ptr != nullptr; }
 
             // TODO Specialize std::get instead
-            template <typename T> T& get() { return *static_cast<T*>(_data.get()); }
+            template <typename T> T& get() {
+                assert(_vtable_ptr == &_vtable<T>);
+                if constexpr (stores_inline<T>) {
+                    return *std::launder(reinterpret_cast<T*>(_storage));
+                } else {
+                    return **reinterpret_cast<T**>(_storage);
+                }
+            }
 
             template <typename T> const T& get() const {
-                return *static_cast<const T*>(_data.get());
+                assert(_vtable_ptr == &_vtable<T>);
+                if constexpr (stores_inline<T>) {
+                    return *std::launder(reinterpret_cast<const T*>(_storage));
+                } else {
+                    return **reinterpret_cast<T* const*>(_storage);
+                }
             }
         };
+
+        template <class T, class... Args> label_holder make_label(Args&&... args) {
+            return label_holder(std::in_place_type<T>, std::forward<Args>(args)...);
+        }
     }  // namespace detail
 
     class Evaluation;
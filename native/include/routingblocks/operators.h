@@ -25,6 +25,7 @@
 
 #include <routingblocks/evaluation.h>
 #include <routingblocks/types.h>
+#include <routingblocks/utility/random.h>
 #include <routingblocks/vertex.h>
 
 #include <memory>
@@ -54,6 +55,18 @@ namespace routingblocks {
          */
         [[nodiscard]] virtual bool can_apply_to(const routingblocks::Solution& sol) const = 0;
 
+        /**
+         * Returns an independent copy of the operator, e.g., for use by another thread. Returns
+         * nullptr if the operator cannot be copied.
+         */
+        [[nodiscard]] virtual std::shared_ptr<destroy_operator> clone() const { return nullptr; }
+
+        /**
+         * Draws fresh seeds for the random number generators of the operator from random. Called
+         * on clones so that each worker draws an independent sequence. Does nothing by default.
+         */
+        virtual void reseed([[maybe_unused]] routingblocks::utility::random& random) {}
+
         virtual ~destroy_operator() = default;
     };
 
@@ -76,6 +89,18 @@ namespace routingblocks {
          */
         [[nodiscard]] virtual bool can_apply_to(const routingblocks::Solution& sol) const = 0;
 
+        /**
+         * Returns an independent copy of the operator, e.g., for use by another thread. Returns
+         * nullptr if the operator cannot be copied.
+         */
+        [[nodiscard]] virtual std::shared_ptr<repair_operator> clone() const { return nullptr; }
+
+        /**
+         * Draws fresh seeds for the random number generators of the operator from random. Called
+         * on clones so that each worker draws an independent sequence. Does nothing by default.
+         */
+        virtual void reseed([[maybe_unused]] routingblocks::utility::random& random) {}
+
         virtual ~repair_operator() = default;
     };
 
@@ -66,7 +66,8 @@ namespace routingblocks {
                                       swap_target_route, swap_target_begin, swap_target_end);
         }
 
-        [[nodiscard]] cost_t evaluate(Evaluation& evaluation, const Instance& instance,
+        template <class evaluation_t>
+        [[nodiscard]] cost_t evaluate(evaluation_t& evaluation, const Instance& instance,
                                       const Solution& solution) const {
             cost_t delta_cost = 0.0;
 
@@ -215,7 +216,8 @@ namespace routingblocks {
                                       moved_segment_begin, moved_segment_end);
         }
 
-        [[nodiscard]] cost_t evaluate(Evaluation& evaluation, const Instance& instance,
+        template <class evaluation_t>
+        [[nodiscard]] cost_t evaluate(evaluation_t& evaluation, const Instance& instance,
                                       const Solution& solution) const {
             cost_t delta_cost{};
 
@@ -308,11 +310,14 @@ namespace routingblocks {
         }
     };
 
-    template <size_t origin_segment_length, size_t target_segment_length> class SwapOperator
-        : public GeneratorArcOperator<SwapMove<origin_segment_length, target_segment_length>> {
+    template <size_t origin_segment_length, size_t target_segment_length,
+              class evaluation_t = Evaluation>
+    class SwapOperator
+        : public GeneratorArcOperator<SwapMove<origin_segment_length, target_segment_length>,
+                                      evaluation_t> {
       public:
-        using GeneratorArcOperator<
-            SwapMove<origin_segment_length, target_segment_length>>::GeneratorArcOperator;
+        using GeneratorArcOperator<SwapMove<origin_segment_length, target_segment_length>,
+                                   evaluation_t>::GeneratorArcOperator;
     };
 
 }  // namespace routingblocks
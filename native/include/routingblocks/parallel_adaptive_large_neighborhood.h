@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2023 Patrick S. Klein (@libklein)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#ifndef routingblocks_PARALLEL_ADAPTIVE_LARGE_NEIGHBORHOOD_H
+#define routingblocks_PARALLEL_ADAPTIVE_LARGE_NEIGHBORHOOD_H
+
+#include <routingblocks/Solution.h>
+#include <routingblocks/evaluation.h>
+#include <routingblocks/operators.h>
+#include <routingblocks/utility/random.h>
+
+#include <memory>
+#include <vector>
+
+namespace routingblocks {
+    struct parallel_alns_parameters {
+        // Number of worker threads, each searching from its own current solution.
+        size_t number_of_workers = 1;
+        // Destroy/repair iterations, summed over all workers.
+        size_t number_of_iterations = 1000;
+        // Each iteration removes a random fraction in [min, max] of the vertices in the solution.
+        double min_removal_factor = 0.1;
+        double max_removal_factor = 0.3;
+        // Iterations of a single worker after which it reports its operator scores. Operator
+        // weights are adapted once every worker has reported since the last adaptation. Workers
+        // that report more than once in the meantime contribute the sum of their scores.
+        size_t period_length = 100;
+        // Weight of the last period's scores when adapting operator weights.
+        double smoothing_factor = 0.4;
+        // Scores awarded to the operators of an iteration that found a new best solution, improved
+        // the worker's current solution, or produced an otherwise accepted solution.
+        double new_best_score = 10.;
+        double improvement_score = 5.;
+        double acceptance_score = 2.;
+        // Workers accept solutions that cost at most (1 + acceptance_threshold) times the best
+        // known cost, and restart from the best known solution once their current solution costs
+        // more than that.
+        double acceptance_threshold = 0.;
+    };
+
+    /**
+     * Adaptive large neighborhood search that runs several workers in parallel. Each worker owns
+     * a random number generator, clones of the registered operators, and a current solution.
+     * Workers share the best solution found so far through a lock-free slot and periodically
+     * aggregate their operator scores into common operator weights.
+     *
+     * Operators must support clone() unless a single worker is used. Workers share the
+     * evaluation, see Evaluation for the resulting requirements.
+     */
+    class parallel_adaptive_large_neighborhood {
+        routingblocks::utility::random _random;
+        parallel_alns_parameters _parameters;
+
+        std::vector<std::shared_ptr<destroy_operator>> _destroy_operators;
+        std::vector<std::shared_ptr<repair_operator>> _repair_operators;
+        std::vector<double> _destroy_operator_weights;
+        std::vector<double> _repair_operator_weights;
+
+      public:
+        parallel_adaptive_large_neighborhood(routingblocks::utility::random random,
+                                             parallel_alns_parameters parameters);
+
+        void add_operator(std::shared_ptr<destroy_operator> op);
+        void add_operator(std::shared_ptr<repair_operator> op);
+
+        /**
+         * Sets the weights of all operators to 1.
+         */
+        void reset_operator_weights();
+
+        /**
+         * Runs the search from the passed solution and returns the best solution found.
+         * Operator weights carry over to subsequent calls.
+         */
+        Solution optimize(Evaluation& evaluation, const Solution& initial_solution);
+
+        [[nodiscard]] const parallel_alns_parameters& parameters() const { return _parameters; }
+
+        [[nodiscard]] const std::vector<std::shared_ptr<destroy_operator>>& destroy_operators()
+            const {
+            return _destroy_operators;
+        }
+        [[nodiscard]] const std::vector<std::shared_ptr<repair_operator>>& repair_operators()
+            const {
+            return _repair_operators;
+        }
+        [[nodiscard]] const std::vector<double>& destroy_operator_weights() const {
+            return _destroy_operator_weights;
+        }
+        [[nodiscard]] const std::vector<double>& repair_operator_weights() const {
+            return _repair_operator_weights;
+        }
+    };
+}  // namespace routingblocks
+
+#endif  // routingblocks_PARALLEL_ADAPTIVE_LARGE_NEIGHBORHOOD_H
@@ -0,0 +1,246 @@
+/*
+ * Copyright (c) 2023 Patrick S. Klein (@libklein)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef routingblocks_RELATEDNESS_MATRIX_H
+#define routingblocks_RELATEDNESS_MATRIX_H
+
+#include <routingblocks/Instance.h>
+#include <routingblocks/types.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace routingblocks::utility {
+    /**
+     * Dense matrix of pairwise vertex relatedness. Larger values indicate more closely related
+     * vertices. Additionally stores, for each vertex, the number_of_neighbors other vertices it is
+     * most related to, ordered by decreasing relatedness.
+     */
+    class relatedness_matrix {
+        size_t _number_of_vertices;
+        size_t _number_of_neighbors;
+        // Row-major, _relatedness[i * _number_of_vertices + j] is the relatedness of i to j.
+        std::vector<float> _relatedness;
+        // Row-major, number_of_neighbors entries per vertex.
+        std::vector<VertexID> _neighbors;
+
+        void _compute_neighbors() {
+            _neighbors.resize(_number_of_vertices * _number_of_neighbors);
+            std::vector<VertexID> candidates;
+            for (VertexID i = 0; i < _number_of_vertices; ++i) {
+                const float* row = &_relatedness[i * _number_of_vertices];
+                candidates.resize(_number_of_vertices);
+                std::iota(candidates.begin(), candidates.end(), VertexID(0));
+                candidates.erase(candidates.begin() + i);
+                // Ties are broken by vertex id to keep neighbor lists deterministic.
+                auto more_related = [row](VertexID lhs, VertexID rhs) {
+                    return row[lhs] > row[rhs] || (row[lhs] == row[rhs] && lhs < rhs);
+                };
+                std::partial_sort(candidates.begin(), candidates.begin() + _number_of_neighbors,
+                                  candidates.end(), more_related);
+                std::copy_n(candidates.begin(), _number_of_neighbors,
+                            _neighbors.begin() + i * _number_of_neighbors);
+            }
+        }
+
+      public:
+        /**
+         * @param number_of_vertices The number of vertices n.
+         * @param relatedness Row-major n x n matrix of relatedness values.
+         * @param number_of_neighbors The length of the neighbor list of each vertex. Capped at
+         * n - 1.
+         */
+        relatedness_matrix(size_t number_of_vertices, std::vector<float> relatedness,
+                           size_t number_of_neighbors)
+            : _number_of_vertices(number_of_vertices),
+              _number_of_neighbors(
+                  std::min(number_of_neighbors,
+                           number_of_vertices > 0 ? number_of_vertices - 1 : size_t(0))),
+              _relatedness(std::move(relatedness)) {
+            if (_relatedness.size() != _number_of_vertices * _number_of_vertices) {
+                throw std::runtime_error("Relatedness matrix must have n x n entries.");
+            }
+            _compute_neighbors();
+        }
+
+        [[nodiscard]] size_t number_of_vertices() const { return _number_of_vertices; }
+        [[nodiscard]] size_t number_of_neighbors() const { return _number_of_neighbors; }
+
+        [[nodiscard]] float relatedness(VertexID i, VertexID j) const {
+            return _relatedness[i * _number_of_vertices + j];
+        }
+
+        /**
+         * Relatedness of vertex i to every vertex, indexed by vertex id.
+         */
+        [[nodiscard]] std::span<const float> row(VertexID i) const {
+            return {_relatedness.data() + i * _number_of_vertices, _number_of_vertices};
+        }
+
+        /**
+         * The vertices most related to vertex i, ordered by decreasing relatedness.
+         */
+        [[nodiscard]] std::span<const VertexID> neighbors(VertexID i) const {
+            return {_neighbors.data() + i * _number_of_neighbors, _number_of_neighbors};
+        }
+    };
+
+    namespace detail {
+        template <class VertexData, class Projection>
+        std::vector<float> gather_vertex_data(const Instance& instance, Projection&& projection) {
+            std::vector<float> values;
+            values.reserve(instance.NumberOfVertices());
+            for (const Vertex& vertex : instance) {
+                values.push_back(projection(vertex.get_data<VertexData>()));
+            }
+            return values;
+        }
+
+        /**
+         * Builds a relatedness matrix whose entries are the inverse of a non-negative distance
+         * measure. compute_row(i, row) stores the distance of vertex i to every vertex j in
+         * row[j]. Rows are computed into contiguous buffers, which lets the compiler vectorize
+         * the distance computations and the inversion.
+         */
+        template <class ComputeRow>
+        relatedness_matrix build_inverse_distance_matrix(const Instance& instance,
+                                                         size_t number_of_neighbors,
+                                                         ComputeRow&& compute_row) {
+            const size_t n = instance.NumberOfVertices();
+            std::vector<float> relatedness(n * n);
+            for (VertexID i = 0; i < n; ++i) {
+                float* row = &relatedness[i * n];
+                compute_row(i, row);
+                for (size_t j = 0; j < n; ++j) {
+                    // Coinciding vertices are maximally related
+                    row[j] = row[j] != 0.f ? 1.f / row[j] : std::numeric_limits<float>::max();
+                }
+                row[i] = 0.f;
+            }
+            return relatedness_matrix(n, std::move(relatedness), number_of_neighbors);
+        }
+
+        template <class ArcData, class Projection>
+        void gather_arc_data(const Instance& instance, VertexID origin, float* row,
+                             Projection&& projection) {
+            for (VertexID j = 0; j < instance.NumberOfVertices(); ++j) {
+                row[j] = projection(instance.getArc(origin, j).get_data<ArcData>());
+            }
+        }
+    }  // namespace detail
+
+    /**
+     * Relates vertices by the inverse of the cost of the arc connecting them.
+     */
+    template <class VertexData, class ArcData>
+    relatedness_matrix build_distance_relatedness_matrix(const Instance& instance,
+                                                         size_t number_of_neighbors) {
+        return detail::build_inverse_distance_matrix(
+            instance, number_of_neighbors, [&](VertexID i, float* row) {
+                detail::gather_arc_data<ArcData>(instance, i, row,
+                                                 [](const ArcData& arc) { return arc.cost; });
+            });
+    }
+
+    /**
+     * Relates vertices by the inverse of t_ij + slack_weight * max(0, e_j - s_i - t_ij - e_i)
+     * + tw_shift_weight * max(0, e_i + s_i + t_ij - l_j), i.e., the travel time plus the waiting
+     * time and the time window violation incurred when serving j directly after i.
+     */
+    template <class VertexData, class ArcData>
+    relatedness_matrix build_spatio_temporal_relatedness_matrix(const Instance& instance,
+                                                                float slack_weight,
+                                                                float tw_shift_weight,
+                                                                size_t number_of_neighbors) {
+        const auto earliest = detail::gather_vertex_data<VertexData>(
+            instance, [](const VertexData& data) { return data.earliest_arrival_time; });
+        const auto latest = detail::gather_vertex_data<VertexData>(
+            instance, [](const VertexData& data) { return data.latest_arrival_time; });
+        const auto service_time = detail::gather_vertex_data<VertexData>(
+            instance, [](const VertexData& data) { return data.service_time; });
+        const size_t n = instance.NumberOfVertices();
+
+        return detail::build_inverse_distance_matrix(
+            instance, number_of_neighbors, [&](VertexID i, float* row) {
+                detail::gather_arc_data<ArcData>(instance, i, row,
+                                                 [](const ArcData& arc) { return arc.duration; });
+                const float e_i = earliest[i];
+                const float s_i = service_time[i];
+                for (size_t j = 0; j < n; ++j) {
+                    const float t_ij = row[j];
+                    row[j] = t_ij + std::max(0.f, earliest[j] - s_i - t_ij - e_i) * slack_weight
+                             + std::max(0.f, e_i + s_i + t_ij - latest[j]) * tw_shift_weight;
+                }
+            });
+    }
+
+    /**
+     * Shaw relatedness. Relates vertices by the inverse of a weighted sum of their distance,
+     * the difference of their demands, and the difference of their earliest arrival times. Each
+     * term is normalized by the range of the respective attribute over the instance.
+     */
+    template <class VertexData, class ArcData>
+    relatedness_matrix build_shaw_relatedness_matrix(const Instance& instance,
+                                                     float distance_weight, float demand_weight,
+                                                     float time_weight,
+                                                     size_t number_of_neighbors) {
+        const auto demand = detail::gather_vertex_data<VertexData>(
+            instance, [](const VertexData& data) { return data.demand; });
+        const auto earliest = detail::gather_vertex_data<VertexData>(
+            instance, [](const VertexData& data) { return data.earliest_arrival_time; });
+        const size_t n = instance.NumberOfVertices();
+
+        float max_distance = 0.f;
+        for (VertexID i = 0; i < n; ++i) {
+            for (VertexID j = 0; j < n; ++j) {
+                max_distance
+                    = std::max(max_distance, instance.getArc(i, j).get_data<ArcData>().cost);
+            }
+        }
+        // Attributes that do not vary across the instance do not contribute.
+        auto scale = [](float weight, float range) { return range > 0.f ? weight / range : 0.f; };
+        const auto [min_demand, max_demand] = std::minmax_element(demand.begin(), demand.end());
+        const auto [min_earliest, max_earliest]
+            = std::minmax_element(earliest.begin(), earliest.end());
+        const float distance_scale = scale(distance_weight, max_distance);
+        const float demand_scale = scale(demand_weight, *max_demand - *min_demand);
+        const float time_scale = scale(time_weight, *max_earliest - *min_earliest);
+
+        return detail::build_inverse_distance_matrix(
+            instance, number_of_neighbors, [&](VertexID i, float* row) {
+                detail::gather_arc_data<ArcData>(instance, i, row,
+                                                 [](const ArcData& arc) { return arc.cost; });
+                const float q_i = demand[i];
+                const float e_i = earliest[i];
+                for (size_t j = 0; j < n; ++j) {
+                    row[j] = distance_scale * row[j] + demand_scale * std::abs(q_i - demand[j])
+                             + time_scale * std::abs(e_i - earliest[j]);
+                }
+            });
+    }
+}  // namespace routingblocks::utility
+
+#endif  // routingblocks_RELATEDNESS_MATRIX_H
@@ -27,8 +27,11 @@
 #include <routingblocks/Solution.h>
 #include <routingblocks/evaluation.h>
 #include <routingblocks/types.h>
+#include <routingblocks/utility/joint_sorted_iterator.h>
 
+#include <algorithm>
 #include <concepts>
+#include <vector>
 
 namespace routingblocks::utility {
 
@@ -49,60 +52,61 @@ namespace routingblocks::utility {
     template <class Comp = std::less<removal_move>> class removal_cache {
       public:
         using move_t = removal_move;
-        using iterator = std::vector<move_t>::iterator;
-        using const_iterator = std::vector<move_t>::const_iterator;
+
+      private:
+        // Sorted removal moves of a single route.
+        using block_t = std::vector<move_t>;
+
+      public:
+        using const_iterator = joint_sorted_iterator<typename block_t::const_iterator, Comp>;
+        using iterator = const_iterator;
 
       private:
         const routingblocks::Instance* _instance;
         routingblocks::Evaluation* _evaluation;
+        // Set if _evaluation supports concatenating forward and backward labels. nullptr
+        // otherwise.
+        routingblocks::ConcatenationBasedEvaluation* _concatenation_evaluation{};
 
-        // Cache structure. Holds all removal moves.
-        std::vector<move_t> _cache;
+        // Cache structure. _cache[r] holds the removal moves of route r ordered according to
+        // _comp. Invalidating a route thus only requires re-sorting the moves of that route.
+        std::vector<block_t> _cache;
         // Comparator
         Comp _comp;
 
-        auto _overwrite_sequence_with_moves_from_route(iterator seq_begin,
-                                                       const routingblocks::Route& route,
-                                                       size_t route_index) {
+        void _update_moves_of_route(const routingblocks::Route& route, size_t route_index) {
+            if (route_index >= _cache.size()) {
+                _cache.resize(route_index + 1);
+            }
+            auto& block = _cache[route_index];
+            block.clear();
+            block.reserve(route.size() - 2);
             auto succ = route.begin();
             auto pred = succ++;
             auto cur = succ++;
             size_t pos = 1;
             auto route_cost = route.cost();
-            for (; succ != route.end(); ++succ, ++pred, ++cur, ++pos, ++seq_begin) {
-                cost_t removal_cost
-                    = concatenate(*_evaluation, *_instance, route_segment{route.begin(), cur},
-                                  route_segment{succ, route.end()});
-                *seq_begin = move_t{cur->vertex_id(), routingblocks::NodeLocation(route_index, pos),
-                                    removal_cost - route_cost};
+            for (; succ != route.end(); ++succ, ++pred, ++cur, ++pos) {
+                cost_t removal_cost;
+                if (_concatenation_evaluation != nullptr) {
+                    // Join pred's forward label with succ's backward label in a single step.
+                    removal_cost = _concatenation_evaluation->concatenate(
+                        _concatenation_evaluation->propagate_forward(
+                            pred->forward_label(), pred->vertex(), succ->vertex(),
+                            _instance->getArc(pred->vertex_id(), succ->vertex_id())),
+                        succ->backward_label(), succ->vertex());
+                } else {
+                    removal_cost
+                        = concatenate(*_evaluation, *_instance, route_segment{route.begin(), cur},
+                                      route_segment{succ, route.end()});
+                }
+                block.push_back(move_t{cur->vertex_id(),
+                                       routingblocks::NodeLocation(route_index, pos),
+                                       removal_cost - route_cost});
             }
-            return seq_begin;
+            std::sort(block.begin(), block.end(), _comp);
         }
 
-        void _update_moves_of_route(const routingblocks::Route& route, size_t route_index) {
-            // Partitions the vector into [route_i, route_j, ..., route_index...]
-            auto first_invalid_move
-                = std::partition(_cache.begin(), _cache.end(), [route_index](const move_t& move) {
-                      return move.node_location.route != route_index;
-                  });
-            const size_t first_invalid_move_index
-                = std::distance(_cache.begin(), first_invalid_move);
-            // Resize the cache to have space for all elements
-            const long prev_route_size = (_cache.size() - first_invalid_move_index);
-            // Could be negative if the route grew.
-            const long route_shrank_by = prev_route_size - (route.size() - 2);
-            assert(route_shrank_by <= static_cast<long long>(_cache.size()));
-            _cache.resize(static_cast<size_t>(_cache.size() - route_shrank_by));
-            // Iterator may have been invalidated
-            first_invalid_move = std::next(_cache.begin(), first_invalid_move_index);
-            // Now just replace
-            auto cache_end
-                = _overwrite_sequence_with_moves_from_route(first_invalid_move, route, route_index);
-            assert(cache_end == _cache.end());
-        }
-
-        void _restore_order() { std::sort(_cache.begin(), _cache.end(), _comp); }
-
       public:
         explicit removal_cache(const routingblocks::Instance& instance)
             : _instance(&instance), _evaluation{}, _cache{} {};
@@ -111,32 +115,42 @@ namespace routingblocks::utility {
 
         void clear() {
             _evaluation = nullptr;
-            _cache.clear();
+            _concatenation_evaluation = nullptr;
+            // Clear blocks rather than dropping them to retain their capacity
+            for (auto& block : _cache) {
+                block.clear();
+            }
         };
 
         void rebuild(routingblocks::Evaluation& evaluation,
                      const routingblocks::Solution& solution) {
             clear();
             _evaluation = &evaluation;
-            _cache.resize(routingblocks::number_of_nodes(solution));
+            _concatenation_evaluation
+                = dynamic_cast<routingblocks::ConcatenationBasedEvaluation*>(&evaluation);
+            _cache.resize(solution.size());
             size_t route_index = 0;
-            auto next_move_storage = _cache.begin();
             for (auto route_iter = solution.begin(); route_iter != solution.end();
                  ++route_index, ++route_iter) {
-                next_move_storage = _overwrite_sequence_with_moves_from_route(
-                    next_move_storage, *route_iter, route_index);
+                _update_moves_of_route(*route_iter, route_index);
             }
-            assert(next_move_storage == _cache.end());
-            _restore_order();
         }
 
         void invalidate_route(const routingblocks::Route& route, size_t route_index) {
             _update_moves_of_route(route, route_index);
-            _restore_order();
         }
 
-        auto begin() const { return _cache.begin(); }
-        auto end() const { return _cache.end(); }
+        [[nodiscard]] const_iterator begin() const {
+            std::vector<std::pair<typename block_t::const_iterator,
+                                  typename block_t::const_iterator>>
+                iters;
+            iters.reserve(_cache.size());
+            for (const auto& block : _cache) {
+                iters.emplace_back(block.begin(), block.end());
+            }
+            return {std::move(iters), &_comp};
+        }
+        [[nodiscard]] const_iterator end() const { return {}; }
     };
 
 }  // namespace routingblocks::utility
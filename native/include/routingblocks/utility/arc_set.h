@@ -49,6 +49,20 @@ namespace routingblocks::utility {
         [[nodiscard]] bool includes_arc(VertexID from, VertexID to) const {
             return _bitset.test(from * _number_of_vertices + to);
         }
+
+        /**
+         * Calls callback(to) for every included arc (from, to) in ascending order of to. Skips
+         * excluded arcs a word at a time, i.e., sparse arc sets are traversed in far fewer than
+         * |V| steps.
+         */
+        template <class Callback> void for_each_target(VertexID from, Callback&& callback) const {
+            const size_t row_begin = from * _number_of_vertices;
+            const size_t row_end = row_begin + _number_of_vertices;
+            size_t next_arc = _bitset.test(row_begin) ? row_begin : _bitset.find_next(row_begin);
+            for (; next_arc < row_end; next_arc = _bitset.find_next(next_arc)) {
+                callback(static_cast<VertexID>(next_arc - row_begin));
+            }
+        }
     };
 }  // namespace routingblocks::utility
 
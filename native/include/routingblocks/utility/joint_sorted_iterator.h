@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2023 Patrick S. Klein (@libklein)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef routingblocks_JOINT_SORTED_ITERATOR_H
+#define routingblocks_JOINT_SORTED_ITERATOR_H
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace routingblocks::utility {
+    /**
+     * Merges several sorted ranges into a single sorted stream. The heads of the ranges are kept in
+     * a binary heap, so advancing the iterator costs O(log k) for k ranges. Ties are broken by the
+     * position of the range in the list passed on construction, which makes the order
+     * deterministic.
+     */
+    template <class child_iterator, class Comp = std::less<typename child_iterator::value_type>>
+    class joint_sorted_iterator {
+      public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = typename child_iterator::value_type;
+        using pointer = typename child_iterator::pointer;
+        using difference_type = std::ptrdiff_t;
+        using reference = typename child_iterator::reference;
+
+      private:
+        struct child_range {
+            child_iterator next;
+            child_iterator end;
+            size_t index;
+        };
+
+        // Min-heap w.r.t. _comp, i.e., _heap.front() holds the next element.
+        std::vector<child_range> _heap;
+        const Comp* _comp;
+
+        // Heap order predicate, "lhs comes after rhs".
+        [[nodiscard]] bool _after(const child_range& lhs, const child_range& rhs) const {
+            if ((*_comp)(*rhs.next, *lhs.next)) return true;
+            if ((*_comp)(*lhs.next, *rhs.next)) return false;
+            return lhs.index > rhs.index;
+        }
+
+        void _sift_down(size_t pos) {
+            const size_t size = _heap.size();
+            while (true) {
+                size_t smallest = pos;
+                const size_t left = 2 * pos + 1;
+                const size_t right = left + 1;
+                if (left < size && _after(_heap[smallest], _heap[left])) smallest = left;
+                if (right < size && _after(_heap[smallest], _heap[right])) smallest = right;
+                if (smallest == pos) return;
+                std::swap(_heap[pos], _heap[smallest]);
+                pos = smallest;
+            }
+        }
+
+        void _advance() {
+            auto& top = _heap.front();
+            if (++top.next == top.end) {
+                top = std::move(_heap.back());
+                _heap.pop_back();
+                if (_heap.empty()) return;
+            }
+            _sift_down(0);
+        }
+
+      public:
+        joint_sorted_iterator(
+            std::vector<std::pair<child_iterator, child_iterator>> child_iterators,
+            const Comp* comp)
+            : _comp(comp) {
+            _heap.reserve(child_iterators.size());
+            for (size_t i = 0; i < child_iterators.size(); ++i) {
+                auto [child_begin, child_end] = child_iterators[i];
+                if (child_begin == child_end) continue;
+                _heap.push_back(child_range{child_begin, child_end, i});
+            }
+            for (size_t i = _heap.size() / 2; i-- > 0;) {
+                _sift_down(i);
+            }
+        };
+
+        joint_sorted_iterator() : _heap(0), _comp(nullptr){};
+
+        joint_sorted_iterator& operator++() {
+            _advance();
+            return *this;
+        }
+
+        joint_sorted_iterator operator++(int) {
+            joint_sorted_iterator tmp = *this;
+            _advance();
+            return tmp;
+        }
+
+        reference operator*() const { return *_heap.front().next; }
+
+        pointer operator->() const { return &*_heap.front().next; }
+
+        bool operator==(const joint_sorted_iterator& other) const {
+            if (_heap.empty() && other._heap.empty()) {
+                return true;
+            } else if (_heap.empty() || other._heap.empty()) {
+                return false;
+            } else {
+                return _heap.front().next == other._heap.front().next;
+            }
+        }
+
+        bool operator!=(const joint_sorted_iterator& other) const { return !(*this == other); }
+    };
+}  // namespace routingblocks::utility
+
+#endif  // routingblocks_JOINT_SORTED_ITERATOR_H
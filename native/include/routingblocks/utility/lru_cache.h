@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2023 Patrick S. Klein (@libklein)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef routingblocks_LRU_CACHE_H
+#define routingblocks_LRU_CACHE_H
+
+#include <cstddef>
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+namespace routingblocks::utility {
+    /**
+     * Map of bounded size. Inserting into a full cache evicts the least recently used entry, where
+     * both insert and find count as a use.
+     */
+    template <class Key, class Value, class Hash = std::hash<Key>> class lru_cache {
+        using entry_t = std::pair<Key, Value>;
+        // Ordered from most to least recently used
+        std::list<entry_t> _entries;
+        std::unordered_map<Key, typename std::list<entry_t>::iterator, Hash> _index;
+        size_t _capacity;
+
+      public:
+        explicit lru_cache(size_t capacity) : _capacity(capacity) {}
+
+        [[nodiscard]] size_t size() const { return _entries.size(); }
+        [[nodiscard]] size_t capacity() const { return _capacity; }
+
+        /**
+         * Returns the value stored for key, or nullptr if there is none. The returned pointer
+         * remains valid until the entry is evicted.
+         */
+        Value* find(const Key& key) {
+            auto entry = _index.find(key);
+            if (entry == _index.end()) {
+                return nullptr;
+            }
+            _entries.splice(_entries.begin(), _entries, entry->second);
+            return &entry->second->second;
+        }
+
+        /**
+         * Stores value for key, replacing the value stored previously.
+         */
+        void insert(const Key& key, Value value) {
+            if (_capacity == 0) return;
+            if (auto* stored_value = find(key)) {
+                *stored_value = std::move(value);
+                return;
+            }
+            if (_entries.size() == _capacity) {
+                _index.erase(_entries.back().first);
+                _entries.pop_back();
+            }
+            _entries.emplace_front(key, std::move(value));
+            _index.emplace(key, _entries.begin());
+        }
+
+        void clear() {
+            _entries.clear();
+            _index.clear();
+        }
+    };
+}  // namespace routingblocks::utility
+
+#endif  // routingblocks_LRU_CACHE_H
@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2023 Patrick S. Klein (@libklein)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef routingblocks_THREAD_POOL_H
+#define routingblocks_THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace routingblocks::utility {
+    /**
+     * Fixed set of worker threads that executes parallel loops. The calling thread takes part in
+     * every loop, so a pool of size n spawns n - 1 threads.
+     */
+    class thread_pool {
+        std::vector<std::thread> _workers;
+
+        std::mutex _mutex;
+        std::condition_variable _work_available;
+        std::condition_variable _work_done;
+
+        // Task of the current loop. nullptr if no loop is running.
+        const std::function<void(size_t)>* _task = nullptr;
+        size_t _number_of_tasks = 0;
+        std::atomic<size_t> _next_task = 0;
+        size_t _active_workers = 0;
+        size_t _generation = 0;
+        bool _stop = false;
+        std::exception_ptr _exception;
+
+        void _run_tasks(const std::function<void(size_t)>& task, size_t number_of_tasks) {
+            for (size_t i; (i = _next_task.fetch_add(1, std::memory_order_relaxed))
+                           < number_of_tasks;) {
+                try {
+                    task(i);
+                } catch (...) {
+                    std::lock_guard lock(_mutex);
+                    if (!_exception) {
+                        _exception = std::current_exception();
+                    }
+                }
+            }
+        }
+
+        void _work() {
+            size_t seen_generation = 0;
+            while (true) {
+                const std::function<void(size_t)>* task;
+                size_t number_of_tasks;
+                {
+                    std::unique_lock lock(_mutex);
+                    _work_available.wait(
+                        lock, [&] { return _stop || _generation != seen_generation; });
+                    if (_stop) {
+                        return;
+                    }
+                    seen_generation = _generation;
+                    // The loop may have completed before this worker woke up.
+                    if (_task == nullptr) {
+                        continue;
+                    }
+                    task = _task;
+                    number_of_tasks = _number_of_tasks;
+                    ++_active_workers;
+                }
+
+                _run_tasks(*task, number_of_tasks);
+
+                {
+                    std::lock_guard lock(_mutex);
+                    if (--_active_workers == 0) {
+                        _work_done.notify_all();
+                    }
+                }
+            }
+        }
+
+      public:
+        explicit thread_pool(size_t number_of_threads) {
+            for (size_t i = 1; i < number_of_threads; ++i) {
+                _workers.emplace_back(&thread_pool::_work, this);
+            }
+        }
+
+        thread_pool(const thread_pool&) = delete;
+        thread_pool& operator=(const thread_pool&) = delete;
+
+        ~thread_pool() {
+            {
+                std::lock_guard lock(_mutex);
+                _stop = true;
+            }
+            _work_available.notify_all();
+            for (auto& worker : _workers) {
+                worker.join();
+            }
+        }
+
+        [[nodiscard]] size_t size() const { return _workers.size() + 1; }
+
+        /**
+         * Calls task(i) for every i in [0, number_of_tasks) and blocks until all calls have
+         * returned. Calls may run concurrently and in any order. Rethrows the first exception
+         * thrown by a task.
+         */
+        template <class Task> void parallel_for(size_t number_of_tasks, Task&& task) {
+            if (_workers.empty() || number_of_tasks <= 1) {
+                for (size_t i = 0; i < number_of_tasks; ++i) {
+                    task(i);
+                }
+                return;
+            }
+
+            const std::function<void(size_t)> wrapped_task(std::ref(task));
+            {
+                std::lock_guard lock(_mutex);
+                _task = &wrapped_task;
+                _number_of_tasks = number_of_tasks;
+                _next_task.store(0, std::memory_order_relaxed);
+                _exception = nullptr;
+                ++_generation;
+            }
+            _work_available.notify_all();
+
+            _run_tasks(wrapped_task, number_of_tasks);
+
+            std::exception_ptr exception;
+            {
+                std::unique_lock lock(_mutex);
+                _task = nullptr;
+                _work_done.wait(lock, [&] { return _active_workers == 0; });
+                exception = std::exchange(_exception, nullptr);
+            }
+            if (exception) {
+                std::rethrow_exception(exception);
+            }
+        }
+    };
+}  // namespace routingblocks::utility
+
+#endif  // routingblocks_THREAD_POOL_H
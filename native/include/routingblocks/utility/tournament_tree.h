@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2023 Patrick S. Klein (@libklein)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef routingblocks_TOURNAMENT_TREE_H
+#define routingblocks_TOURNAMENT_TREE_H
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace routingblocks::utility {
+    /**
+     * Winner tree over a fixed number of leaves, each of which is either empty or competes with
+     * a key known to the caller. Every node stores the index of the best non-empty leaf in its
+     * subtree, or npos if the subtree has no non-empty leaf. Changing a single leaf replays only
+     * the matches on its path to the root, i.e., costs O(log n) comparisons.
+     *
+     * Nodes are numbered like a binary heap: the root is node 1 and node i has the children 2i
+     * and 2i + 1. Ties go to the leaf with the smaller index.
+     */
+    class tournament_tree {
+      public:
+        static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+      private:
+        // Leaves occupy nodes [_first_leaf, 2 * _first_leaf).
+        size_t _first_leaf = 1;
+        std::vector<size_t> _nodes;
+
+        template <class Better> static size_t _play(size_t lhs, size_t rhs, Better& better) {
+            if (lhs == npos) return rhs;
+            if (rhs == npos) return lhs;
+            return better(rhs, lhs) ? rhs : lhs;
+        }
+
+      public:
+        explicit tournament_tree(size_t number_of_leaves = 0) { reset(number_of_leaves); }
+
+        /**
+         * Empties all leaves and makes room for at least number_of_leaves leaves.
+         */
+        void reset(size_t number_of_leaves) {
+            _first_leaf = std::bit_ceil(std::max(number_of_leaves, size_t(1)));
+            _nodes.assign(2 * _first_leaf, npos);
+        }
+
+        [[nodiscard]] size_t capacity() const { return _first_leaf; }
+
+        /**
+         * Marks the leaf as (non-)empty without replaying any matches. Call replay afterwards.
+         */
+        void set(size_t leaf, bool non_empty) {
+            _nodes[_first_leaf + leaf] = non_empty ? leaf : npos;
+        }
+
+        /**
+         * Replays all matches. better(lhs, rhs) returns true if leaf lhs beats leaf rhs.
+         */
+        template <class Better> void replay(Better&& better) {
+            for (size_t node = _first_leaf; node-- > 1;) {
+                _nodes[node] = _play(_nodes[2 * node], _nodes[2 * node + 1], better);
+            }
+        }
+
+        /**
+         * Marks the leaf as (non-)empty and replays the matches on its path to the root.
+         * better(lhs, rhs) returns true if leaf lhs beats leaf rhs.
+         */
+        template <class Better> void update(size_t leaf, bool non_empty, Better&& better) {
+            size_t node = _first_leaf + leaf;
+            _nodes[node] = non_empty ? leaf : npos;
+            for (node /= 2; node > 0; node /= 2) {
+                _nodes[node] = _play(_nodes[2 * node], _nodes[2 * node + 1], better);
+            }
+        }
+
+        [[nodiscard]] static constexpr size_t root() { return 1; }
+        [[nodiscard]] bool is_leaf(size_t node) const { return node >= _first_leaf; }
+
+        /**
+         * Returns the best non-empty leaf in the subtree of node, or npos if there is none.
+         */
+        [[nodiscard]] size_t winner(size_t node = root()) const { return _nodes[node]; }
+    };
+}  // namespace routingblocks::utility
+
+#endif  // routingblocks_TOURNAMENT_TREE_H
@@ -21,6 +21,8 @@
 
 #include <algorithm>
 #include <iostream>
+#include <iterator>
+#include <stdexcept>
 
 using namespace routingblocks;
 
@@ -34,17 +36,36 @@ namespace {
         vertices.insert(vertices.end(), stations.begin(), stations.end());
         return vertices;
     }
+
+    std::vector<Arc> _flatten_arcs(std::vector<std::vector<Arc>> arcs) {
+        std::vector<Arc> flat_arcs;
+        flat_arcs.reserve(arcs.size() * arcs.size());
+        for (auto& row : arcs) {
+            if (row.size() != arcs.size()) {
+                throw std::runtime_error("Arc matrix is not square");
+            }
+            std::move(row.begin(), row.end(), std::back_inserter(flat_arcs));
+        }
+        return flat_arcs;
+    }
 }  // namespace
 
 Instance::Instance(std::vector<Vertex> vertices, std::vector<std::vector<Arc>> arcs)
     : Instance(std::move(vertices), std::move(arcs), 0) {}
 
 Instance::Instance(std::vector<Vertex> vertices, std::vector<std::vector<Arc>> arcs, int fleetSize)
+    : Instance(std::move(vertices), _flatten_arcs(std::move(arcs)), fleetSize) {}
+
+Instance::Instance(std::vector<Vertex> vertices, std::vector<Arc> arcs, int fleetSize)
     : _vertices(std::move(vertices)), _arcs(std::move(arcs)), _fleet_size(fleetSize) {
     if (_vertices.size() <= 1) {
         throw std::runtime_error("Cannot create instance with less than 2 vertices");
     }
 
+    if (_arcs.size() != _vertices.size() * _vertices.size()) {
+        throw std::runtime_error("Arc matrix does not match the number of vertices");
+    }
+
     // vertices should be ordered as [depot, cust_1, ..., cust_n, station_1, ..., station_n]
     auto next_vertex = _vertices.begin();
     size_t next_vertex_id = 0;
@@ -21,6 +21,7 @@
 #include <routingblocks/LocalSearch.h>
 #include <routingblocks/Solution.h>
 
+#include <algorithm>
 #include <set>
 
 namespace routingblocks {
@@ -31,6 +32,14 @@ namespace routingblocks {
         bool skip_remaining_operators = false;
         for (auto& next_op : _operators) {
             next_op->prepare_search(_current_solution);
+            if (_thread_pool && next_op->number_of_partitions(_current_solution) > 0) {
+                skip_remaining_operators = !_explore_neighborhood_in_parallel(*next_op);
+                next_op->finalize_search();
+                if (skip_remaining_operators) {
+                    break;
+                }
+                continue;
+            }
             while (true) {
                 next_move = next_op->find_next_improving_move(*_evaluation, _current_solution,
                                                               next_move.get());
@@ -51,7 +60,42 @@ namespace routingblocks {
         return _pivoting_rule->select_move(_current_solution);
     }
 
-    cost_t LocalSearch::_test_move(const Move& move) {
+    bool LocalSearch::_explore_neighborhood_in_parallel(Operator& op) {
+        const size_t number_of_partitions = op.number_of_partitions(_current_solution);
+        std::vector<std::vector<std::pair<std::shared_ptr<Move>, cost_t>>> partition_moves;
+
+        // Search the partitions in batches of growing size. This bounds the work wasted when
+        // the pivoting rule terminates early, e.g., on the first improving move.
+        size_t batch_size = _thread_pool->size();
+        for (size_t batch_begin = 0; batch_begin < number_of_partitions;
+             batch_begin += batch_size, batch_size *= 2) {
+            const size_t batch_end = std::min(batch_begin + batch_size, number_of_partitions);
+            partition_moves.clear();
+            partition_moves.resize(batch_end - batch_begin);
+
+            _thread_pool->parallel_for(batch_end - batch_begin, [&](size_t i) {
+                auto& tested_moves = partition_moves[i];
+                for (auto& move :
+                     op.find_improving_moves(*_evaluation, _current_solution, batch_begin + i)) {
+                    const cost_t cost = _test_move(*move);
+                    tested_moves.emplace_back(std::move(move), cost);
+                }
+            });
+
+            // Reduce in partition order to replicate the sequential search.
+            for (auto& tested_moves : partition_moves) {
+                for (auto& [move, cost] : tested_moves) {
+                    if (cost < -1e-2
+                        && !_pivoting_rule->continue_search(move, cost, _current_solution)) {
+                        return false;
+                    }
+                }
+            }
+        }
+        return true;
+    }
+
+    cost_t LocalSearch::_test_move(const Move& move) const {
         if (_exact_evaluation) {
             return move.get_cost_delta(*_exact_evaluation, *_instance, _current_solution);
         } else {
@@ -65,11 +109,16 @@ namespace routingblocks {
 
     LocalSearch::LocalSearch(const routingblocks::Instance& instance,
                              std::shared_ptr<eval_t> evaluation,
-                             std::shared_ptr<eval_t> exact_evaluation, PivotingRule* pivoting_rule)
+                             std::shared_ptr<eval_t> exact_evaluation, PivotingRule* pivoting_rule,
+                             size_t number_of_threads)
         : _instance(&instance),
           _evaluation(std::move(evaluation)),
           _exact_evaluation(std::move(exact_evaluation)),
           _pivoting_rule(pivoting_rule),
-          _current_solution(_evaluation, *_instance, _instance->FleetSize()) {}
+          _current_solution(_evaluation, *_instance, _instance->FleetSize()) {
+        if (number_of_threads > 1) {
+            _thread_pool = std::make_unique<utility::thread_pool>(number_of_threads);
+        }
+    }
 
 }  // namespace routingblocks
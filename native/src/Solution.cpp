@@ -19,6 +19,7 @@
 
 #include <routingblocks/Solution.h>
 
+#include <algorithm>
 #include <numeric>
 
 namespace routingblocks {
@@ -29,42 +30,65 @@ namespace routingblocks {
 
     bool NodeLocation::operator!=(const NodeLocation& rhs) const { return !(rhs == *this); }
 
-    void Solution::_update_vertex_lookup(unsigned int route_index) {
+    void Solution::_unregister_nodes(size_t route_index, size_t first_position) {
         const auto& route = _routes[route_index];
-        auto node_iter = route.begin();
-        for (auto node_index = 0u; node_index < route.size(); ++node_index, ++node_iter) {
-            const auto& node = *node_iter;
-            // Remove old entries
-            auto& vertex_lookup = _vertex_lookup[node.vertex_id()];
-            /*vertex_lookup.erase(std::remove_if(
-                vertex_lookup.begin(), vertex_lookup.end(),
-                [route_index](const NodeLocation& loc) { return loc.route == route_index; }));*/
-            // Update
-            vertex_lookup.emplace_back(route_index, node_index);
+        for (auto position = first_position; position < route.size(); ++position) {
+            auto& vertex_lookup
+                = _vertex_lookup[std::next(route.begin(), position)->vertex_id()];
+            NodeLocation location(route_index, position);
+            auto entry = std::lower_bound(vertex_lookup.begin(), vertex_lookup.end(), location);
+            if (entry != vertex_lookup.end() && *entry == location) {
+                vertex_lookup.erase(entry);
+            }
         }
     }
+
+    void Solution::_register_nodes(size_t route_index, size_t first_position) {
+        const auto& route = _routes[route_index];
+        for (auto position = first_position; position < route.size(); ++position) {
+            auto& vertex_lookup
+                = _vertex_lookup[std::next(route.begin(), position)->vertex_id()];
+            // Keep locations sorted
+            NodeLocation location(route_index, position);
+            vertex_lookup.insert(
+                std::upper_bound(vertex_lookup.begin(), vertex_lookup.end(), location), location);
+        }
+    }
+
     void Solution::_update_vertex_lookup() {
         for (auto& lookup : _vertex_lookup) lookup.clear();
 
-        for (unsigned int route_index = 0u; route_index < _routes.size(); ++route_index) {
-            _update_vertex_lookup(route_index);
+        for (size_t route_index = 0; route_index < _routes.size(); ++route_index) {
+            _register_nodes(route_index);
         }
     }
+
     void Solution::exchange_segment(Solution::iterator from_route,
                                     typename route_t::iterator from_route_segment_begin,
                                     typename route_t::iterator from_route_segment_end,
                                     Solution::iterator to_route,
                                     typename route_t::iterator to_route_segment_begin,
                                     typename route_t::iterator to_route_segment_end) {
+        const auto from_route_index = static_cast<size_t>(std::distance(begin(), from_route));
+        const auto to_route_index = static_cast<size_t>(std::distance(begin(), to_route));
+        const auto from_position = static_cast<size_t>(
+            std::distance(from_route->begin(), from_route_segment_begin));
+        const auto to_position
+            = static_cast<size_t>(std::distance(to_route->begin(), to_route_segment_begin));
         if (from_route != to_route) {
+            _unregister_nodes(from_route_index, from_position);
+            _unregister_nodes(to_route_index, to_position);
             from_route->exchange_segments(from_route_segment_begin, from_route_segment_end,
                                           to_route_segment_begin, to_route_segment_end, *to_route);
+            _register_nodes(from_route_index, from_position);
+            _register_nodes(to_route_index, to_position);
         } else {
+            const auto first_position = std::min(from_position, to_position);
+            _unregister_nodes(from_route_index, first_position);
             from_route->exchange_segments(from_route_segment_begin, from_route_segment_end,
                                           to_route_segment_begin, to_route_segment_end);
+            _register_nodes(from_route_index, first_position);
         }
-        // Update
-        _update_vertex_lookup();
     }
 
     Solution::route_t::iterator Solution::insert_vertex_after(Solution::iterator route,
@@ -74,18 +98,24 @@ namespace routingblocks {
         std::array<route_t::node_t, 1> temporary_segment
             = {route_t::node_t(inserted_vertex, _evaluation->create_forward_label(inserted_vertex),
                                _evaluation->create_backward_label(inserted_vertex))};
+        const auto route_index = static_cast<size_t>(std::distance(begin(), route));
+        const auto first_position = static_cast<size_t>(std::distance(route->begin(), pos)) + 1;
+        _unregister_nodes(route_index, first_position);
         auto new_pos
             = route->insert_segment_after(pos, std::make_move_iterator(temporary_segment.begin()),
                                           std::make_move_iterator(temporary_segment.end()));
-        _update_vertex_lookup();
+        _register_nodes(route_index, first_position);
         return new_pos;
     }
 
     Solution::route_t::iterator Solution::remove_route_segment(Solution::iterator route,
                                                                typename route_t::iterator begin,
                                                                typename route_t::iterator end) {
+        const auto route_index = static_cast<size_t>(std::distance(this->begin(), route));
+        const auto first_position = static_cast<size_t>(std::distance(route->begin(), begin));
+        _unregister_nodes(route_index, first_position);
         auto new_pos = route->remove_segment(begin, end);
-        _update_vertex_lookup();
+        _register_nodes(route_index, first_position);
         return new_pos;
     }
     auto Solution::remove_vertex(Solution::iterator route, typename route_t::iterator position) ->
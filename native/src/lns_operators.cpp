@@ -20,6 +20,10 @@
 #include <routingblocks/Solution.h>
 #include <routingblocks/lns_operators.h>
 
+#include <algorithm>
+#include <cassert>
+#include <numeric>
+
 namespace routingblocks::lns::operators {
 
     std::vector<routingblocks::NodeLocation> sample_positions(
@@ -80,6 +84,492 @@ namespace routingblocks::lns::operators {
         return true;
     }
 
+    std::shared_ptr<routingblocks::destroy_operator> RandomRemoval::clone() const {
+        return std::make_shared<RandomRemoval>(*this);
+    }
+
+    void RandomRemoval::reseed(utility::random& random) {
+        _random = utility::random(random());
+    }
+
+    size_t FirstMoveSelector::select([[maybe_unused]] size_t number_of_moves) {
+        assert(number_of_moves > 0);
+        return 0;
+    }
+
+    std::unique_ptr<MoveSelector> FirstMoveSelector::clone() const {
+        return std::make_unique<FirstMoveSelector>(*this);
+    }
+
+    size_t LastMoveSelector::select(size_t number_of_moves) {
+        assert(number_of_moves > 0);
+        return number_of_moves - 1;
+    }
+
+    std::unique_ptr<MoveSelector> LastMoveSelector::clone() const {
+        return std::make_unique<LastMoveSelector>(*this);
+    }
+
+    NthMoveSelector::NthMoveSelector(size_t n) : _n(n) {
+        if (n == 0) {
+            throw std::runtime_error("NthMoveSelector: n must be positive.");
+        }
+    }
+
+    size_t NthMoveSelector::select(size_t number_of_moves) {
+        assert(number_of_moves > 0);
+        return std::min(_n, number_of_moves) - 1;
+    }
+
+    std::unique_ptr<MoveSelector> NthMoveSelector::clone() const {
+        return std::make_unique<NthMoveSelector>(*this);
+    }
+
+    BlinkMoveSelector::BlinkMoveSelector(double blink_probability, utility::random random)
+        : _blink_probability(blink_probability), _random(std::move(random)) {
+        if (blink_probability < 0. || blink_probability > 1.) {
+            throw std::runtime_error("BlinkMoveSelector: blink probability must be in [0, 1].");
+        }
+    }
+
+    size_t BlinkMoveSelector::select(size_t number_of_moves) {
+        assert(number_of_moves > 0);
+        for (size_t i = 0; i + 1 < number_of_moves; ++i) {
+            if (_random.uniform(0., 1.) > _blink_probability) {
+                return i;
+            }
+        }
+        return number_of_moves - 1;
+    }
+
+    std::unique_ptr<MoveSelector> BlinkMoveSelector::clone() const {
+        return std::make_unique<BlinkMoveSelector>(*this);
+    }
+
+    void BlinkMoveSelector::reseed(utility::random& random) {
+        _random = utility::random(random());
+    }
+
+    size_t RandomMoveSelector::select(size_t number_of_moves) {
+        assert(number_of_moves > 0);
+        return _random.generateInt(static_cast<size_t>(0), number_of_moves - 1);
+    }
+
+    std::unique_ptr<MoveSelector> RandomMoveSelector::clone() const {
+        return std::make_unique<RandomMoveSelector>(*this);
+    }
+
+    void RandomMoveSelector::reseed(utility::random& random) {
+        _random = utility::random(random());
+    }
+
+    std::optional<routingblocks::NodeLocation> StationSeedSelector::select(
+        [[maybe_unused]] routingblocks::Evaluation& evaluation,
+        const routingblocks::Solution& solution,
+        const std::vector<routingblocks::NodeLocation>& already_selected) {
+        _candidates.clear();
+        for (auto station : _stations) {
+            for (const auto& location : solution.find(station)) {
+                if (std::find(already_selected.begin(), already_selected.end(), location)
+                    == already_selected.end()) {
+                    _candidates.push_back(location);
+                }
+            }
+        }
+        if (_candidates.empty()) {
+            return {};
+        }
+        return _candidates[_random.generateInt(static_cast<size_t>(0), _candidates.size() - 1)];
+    }
+
+    std::unique_ptr<SeedSelector> StationSeedSelector::clone() const {
+        return std::make_unique<StationSeedSelector>(*this);
+    }
+
+    void StationSeedSelector::reseed(utility::random& random) {
+        _random = utility::random(random());
+    }
+
+    DistanceBasedClusterMemberSelector::DistanceBasedClusterMemberSelector(
+        const std::vector<routingblocks::VertexID>& vertices,
+        const std::function<resource_t(routingblocks::VertexID, routingblocks::VertexID)>&
+            get_distance,
+        resource_t min_radius_factor, resource_t max_radius_factor, utility::random random)
+        : _min_radius_factor(min_radius_factor),
+          _max_radius_factor(max_radius_factor),
+          _random(std::move(random)) {
+        if (min_radius_factor > max_radius_factor) {
+            throw std::runtime_error(
+                "DistanceBasedClusterMemberSelector: min_radius_factor must not exceed "
+                "max_radius_factor.");
+        }
+        if (vertices.empty()) return;
+
+        _distance_list.resize(*std::max_element(vertices.begin(), vertices.end()) + 1);
+        for (auto i : vertices) {
+            auto& distances = _distance_list[i];
+            distances.reserve(vertices.size());
+            for (auto j : vertices) {
+                auto distance = get_distance(i, j);
+                distances.emplace_back(distance, j);
+                _max_distance = std::max(_max_distance, distance);
+            }
+            // Stable to keep the order of vertices with equal distance deterministic.
+            std::stable_sort(
+                distances.begin(), distances.end(),
+                [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+        }
+    }
+
+    resource_t DistanceBasedClusterMemberSelector::_pick_radius() {
+        if (_min_radius_factor == _max_radius_factor) {
+            return _min_radius_factor * _max_distance;
+        }
+        return _random.uniform(_min_radius_factor, _max_radius_factor) * _max_distance;
+    }
+
+    std::vector<routingblocks::NodeLocation> DistanceBasedClusterMemberSelector::select(
+        [[maybe_unused]] routingblocks::Evaluation& evaluation,
+        const routingblocks::Solution& solution, const routingblocks::NodeLocation& seed) {
+        std::vector<routingblocks::NodeLocation> members;
+        auto seed_vertex = routingblocks::to_ref(seed, solution).second->vertex_id();
+        if (seed_vertex >= _distance_list.size()) {
+            return members;
+        }
+
+        const auto& closest_vertices = _distance_list[seed_vertex];
+        auto cutoff = std::lower_bound(
+            closest_vertices.begin(), closest_vertices.end(), _pick_radius(),
+            [](const auto& item, resource_t radius) { return item.first < radius; });
+        for (auto item = closest_vertices.begin(); item != cutoff; ++item) {
+            const auto& locations = solution.find(item->second);
+            members.insert(members.end(), locations.begin(), locations.end());
+        }
+        return members;
+    }
+
+    std::unique_ptr<ClusterMemberSelector> DistanceBasedClusterMemberSelector::clone() const {
+        return std::make_unique<DistanceBasedClusterMemberSelector>(*this);
+    }
+
+    void DistanceBasedClusterMemberSelector::reseed(utility::random& random) {
+        _random = utility::random(random());
+    }
+
+    RelatedRemoval::RelatedRemoval(const utility::relatedness_matrix& relatedness_matrix,
+                                   const MoveSelector& move_selector,
+                                   const MoveSelector& seed_selector,
+                                   const MoveSelector& initial_seed_selector, size_t cluster_size)
+        : _relatedness_matrix(&relatedness_matrix),
+          _move_selector(move_selector.clone()),
+          _seed_selector(seed_selector.clone()),
+          _initial_seed_selector(initial_seed_selector.clone()),
+          _cluster_size(cluster_size) {
+        if (cluster_size == 0) {
+            throw std::runtime_error("RelatedRemoval: cluster size must be positive.");
+        }
+    }
+
+    std::vector<routingblocks::VertexID> RelatedRemoval::apply(
+        [[maybe_unused]] routingblocks::Evaluation& evaluation, routingblocks::Solution& sol,
+        size_t numberOfRemovedCustomers) {
+        std::vector<routingblocks::VertexID> removed_vertices;
+        if (numberOfRemovedCustomers == 0) return removed_vertices;
+
+        _nodes_in_solution.clear();
+        _vertices_in_solution.clear();
+        size_t route_index = 0;
+        for (auto route_iter = sol.begin(); route_iter != sol.end(); ++route_iter, ++route_index) {
+            size_t position = 1;
+            for (auto node_iter = std::next(route_iter->begin());
+                 node_iter != route_iter->end_depot(); ++node_iter, ++position) {
+                if (node_iter->vertex_id() >= _relatedness_matrix->number_of_vertices()) {
+                    throw std::runtime_error(
+                        "RelatedRemoval: relatedness matrix does not cover all vertices.");
+                }
+                _nodes_in_solution.emplace_back(route_index, position);
+                _vertices_in_solution.push_back(node_iter->vertex_id());
+            }
+        }
+        if (numberOfRemovedCustomers > _nodes_in_solution.size()) {
+            throw std::runtime_error("Cannot remove more nodes than are in the solution!");
+        }
+
+        // Group the nodes by the vertex they visit: the nodes visiting vertex v are
+        // _nodes_by_vertex[_vertex_offsets[v]], ..., _nodes_by_vertex[_vertex_offsets[v + 1] - 1].
+        const size_t number_of_vertices = _relatedness_matrix->number_of_vertices();
+        _vertex_offsets.assign(number_of_vertices + 1, 0);
+        for (auto vertex : _vertices_in_solution) {
+            ++_vertex_offsets[vertex + 1];
+        }
+        std::partial_sum(_vertex_offsets.begin(), _vertex_offsets.end(), _vertex_offsets.begin());
+        _nodes_by_vertex.resize(_nodes_in_solution.size());
+        for (size_t i = 0; i < _nodes_in_solution.size(); ++i) {
+            _nodes_by_vertex[_vertex_offsets[_vertices_in_solution[i]]++] = i;
+        }
+        std::copy_backward(_vertex_offsets.begin(), std::prev(_vertex_offsets.end()),
+                           _vertex_offsets.end());
+        _vertex_offsets[0] = 0;
+
+        // Removed nodes, as indices into _nodes_in_solution.
+        std::vector<size_t> removed;
+        removed.reserve(numberOfRemovedCustomers);
+        std::vector<bool> is_removed(_nodes_in_solution.size(), false);
+
+        auto initial_seed = _initial_seed_selector->select(_nodes_in_solution.size());
+        removed.push_back(initial_seed);
+        is_removed[initial_seed] = true;
+
+        while (removed.size() < numberOfRemovedCustomers) {
+            auto cluster_size = std::min(numberOfRemovedCustomers - removed.size(), _cluster_size);
+            auto seed = removed[_seed_selector->select(removed.size())];
+            auto seed_vertex = _vertices_in_solution[seed];
+            auto relatedness = _relatedness_matrix->row(seed_vertex);
+            auto neighbors = _relatedness_matrix->neighbors(seed_vertex);
+
+            // Remaining nodes are ordered by relatedness to the seed, most related first. Ties
+            // retain the order of the nodes in the solution.
+            auto more_related = [&](size_t lhs, size_t rhs) {
+                auto lhs_relatedness = relatedness[_vertices_in_solution[lhs]];
+                auto rhs_relatedness = relatedness[_vertices_in_solution[rhs]];
+                return lhs_relatedness > rhs_relatedness
+                       || (lhs_relatedness == rhs_relatedness && lhs < rhs);
+            };
+
+            // Vertices outside the neighbor list of the seed are at most as related as its last
+            // entry. The remaining nodes visiting more related vertices thus form a prefix of the
+            // order, which usually suffices for the move selector.
+            _candidates.clear();
+            if (!neighbors.empty()) {
+                const bool covers_all_vertices = neighbors.size() + 1 == number_of_vertices;
+                const auto least_relatedness = relatedness[neighbors.back()];
+                auto add_remaining_visits = [&](routingblocks::VertexID vertex) {
+                    if (!covers_all_vertices && !(relatedness[vertex] > least_relatedness)) return;
+                    for (auto i = _vertex_offsets[vertex]; i < _vertex_offsets[vertex + 1]; ++i) {
+                        if (!is_removed[_nodes_by_vertex[i]]) {
+                            _candidates.push_back(_nodes_by_vertex[i]);
+                        }
+                    }
+                };
+                add_remaining_visits(seed_vertex);
+                for (auto neighbor : neighbors) {
+                    add_remaining_visits(neighbor);
+                }
+            }
+            std::sort(_candidates.begin(), _candidates.end(), more_related);
+
+            bool considers_all_remaining = false;
+            for (size_t i = 0; i < cluster_size; ++i) {
+                auto selected
+                    = _move_selector->select(_nodes_in_solution.size() - removed.size());
+                size_t picked;
+                if (selected < _candidates.size() && !considers_all_remaining) {
+                    picked = _candidates[selected];
+                    _candidates.erase(std::next(_candidates.begin(), selected));
+                } else {
+                    // The selector reaches beyond the prefix, fall back to all remaining nodes.
+                    if (!considers_all_remaining) {
+                        _candidates.clear();
+                        for (size_t node = 0; node < _nodes_in_solution.size(); ++node) {
+                            if (!is_removed[node]) _candidates.push_back(node);
+                        }
+                        considers_all_remaining = true;
+                    }
+                    std::nth_element(_candidates.begin(), std::next(_candidates.begin(), selected),
+                                     _candidates.end(), more_related);
+                    picked = _candidates[selected];
+                    _candidates[selected] = _candidates.back();
+                    _candidates.pop_back();
+                }
+                removed.push_back(picked);
+                is_removed[picked] = true;
+            }
+        }
+
+        std::vector<routingblocks::NodeLocation> locations;
+        locations.reserve(removed.size());
+        removed_vertices.reserve(removed.size());
+        for (auto index : removed) {
+            locations.push_back(_nodes_in_solution[index]);
+            removed_vertices.push_back(_vertices_in_solution[index]);
+        }
+        sol.remove_vertices(locations.begin(), locations.end());
+        return removed_vertices;
+    }
+
+    std::string_view RelatedRemoval::name() const { return "RelatedRemoval"; }
+
+    bool RelatedRemoval::can_apply_to(const routingblocks::Solution& sol) const {
+        return sol.size() > 0;
+    }
+
+    std::shared_ptr<routingblocks::destroy_operator> RelatedRemoval::clone() const {
+        return std::make_shared<RelatedRemoval>(*_relatedness_matrix, *_move_selector,
+                                                *_seed_selector, *_initial_seed_selector,
+                                                _cluster_size);
+    }
+
+    void RelatedRemoval::reseed(utility::random& random) {
+        _move_selector->reseed(random);
+        _seed_selector->reseed(random);
+        _initial_seed_selector->reseed(random);
+    }
+
+    WorstRemoval::WorstRemoval(const routingblocks::Instance& instance,
+                               const MoveSelector& move_selector)
+        : _instance(&instance), _removal_cache(instance), _move_selector(move_selector.clone()) {}
+
+    std::vector<routingblocks::VertexID> WorstRemoval::apply(routingblocks::Evaluation& evaluation,
+                                                             routingblocks::Solution& sol,
+                                                             size_t numberOfRemovedCustomers) {
+        std::vector<routingblocks::VertexID> removed_vertices;
+        removed_vertices.reserve(numberOfRemovedCustomers);
+        auto remaining_nodes = routingblocks::number_of_nodes(sol);
+        if (numberOfRemovedCustomers > remaining_nodes) {
+            throw std::runtime_error("Cannot remove more nodes than are in the solution!");
+        }
+
+        _removal_cache.rebuild(evaluation, sol);
+        // The cache holds exactly one move per node.
+        for (; removed_vertices.size() < numberOfRemovedCustomers; --remaining_nodes) {
+            const auto move = *std::next(_removal_cache.begin(),
+                                         _move_selector->select(remaining_nodes));
+            auto [route_iter, node_iter] = routingblocks::to_iter(move.node_location, sol);
+            sol.remove_vertex(route_iter, node_iter);
+            _removal_cache.invalidate_route(*route_iter, move.node_location.route);
+            removed_vertices.push_back(move.vertex_id);
+        }
+        return removed_vertices;
+    }
+
+    std::string_view WorstRemoval::name() const { return "WorstRemoval"; }
+
+    bool WorstRemoval::can_apply_to(const routingblocks::Solution& sol) const {
+        return sol.size() > 0;
+    }
+
+    std::shared_ptr<routingblocks::destroy_operator> WorstRemoval::clone() const {
+        return std::make_shared<WorstRemoval>(*_instance, *_move_selector);
+    }
+
+    void WorstRemoval::reseed(utility::random& random) {
+        _move_selector->reseed(random);
+    }
+
+    ClusterRemoval::ClusterRemoval(const SeedSelector& seed_selector,
+                                   const ClusterMemberSelector& cluster_member_selector)
+        : _seed_selector(seed_selector.clone()),
+          _cluster_member_selector(cluster_member_selector.clone()) {}
+
+    ClusterRemoval::ClusterRemoval(const ClusterRemoval& other)
+        : ClusterRemoval(*other._seed_selector, *other._cluster_member_selector) {}
+
+    std::vector<routingblocks::VertexID> ClusterRemoval::apply(
+        routingblocks::Evaluation& evaluation, routingblocks::Solution& sol,
+        size_t numberOfRemovedCustomers) {
+        std::vector<routingblocks::NodeLocation> removed_locations;
+        removed_locations.reserve(numberOfRemovedCustomers);
+        while (sol.size() > 0 && removed_locations.size() < numberOfRemovedCustomers) {
+            auto seed = _seed_selector->select(evaluation, sol, removed_locations);
+            if (!seed) break;
+
+            bool selected_any = false;
+            for (const auto& member : _cluster_member_selector->select(evaluation, sol, *seed)) {
+                // Clusters of different seeds may overlap.
+                if (std::find(removed_locations.begin(), removed_locations.end(), member)
+                    != removed_locations.end()) {
+                    continue;
+                }
+                removed_locations.push_back(member);
+                selected_any = true;
+                if (removed_locations.size() == numberOfRemovedCustomers) break;
+            }
+            // The seed selector would keep proposing seeds with empty clusters otherwise.
+            if (!selected_any) break;
+        }
+
+        std::vector<routingblocks::VertexID> removed_vertices(removed_locations.size());
+        std::transform(removed_locations.begin(), removed_locations.end(),
+                       removed_vertices.begin(),
+                       [&sol](const routingblocks::NodeLocation& location) {
+                           return routingblocks::to_ref(location, sol).second->vertex_id();
+                       });
+        sol.remove_vertices(removed_locations.begin(), removed_locations.end());
+        return removed_vertices;
+    }
+
+    std::string_view ClusterRemoval::name() const { return "ClusterRemoval"; }
+
+    bool ClusterRemoval::can_apply_to(const routingblocks::Solution& sol) const {
+        return sol.size() > 0;
+    }
+
+    std::shared_ptr<routingblocks::destroy_operator> ClusterRemoval::clone() const {
+        return std::make_shared<ClusterRemoval>(*this);
+    }
+
+    void ClusterRemoval::reseed(utility::random& random) {
+        _seed_selector->reseed(random);
+        _cluster_member_selector->reseed(random);
+    }
+
+    namespace {
+        ClusterRemoval make_station_vicinity_cluster_removal(
+            const routingblocks::Instance& instance,
+            const std::function<resource_t(routingblocks::VertexID, routingblocks::VertexID)>&
+                get_distance,
+            resource_t min_radius_factor, resource_t max_radius_factor,
+            utility::random& random) {
+            std::vector<routingblocks::VertexID> stations;
+            for (const auto& station : instance.Stations()) {
+                stations.push_back(station.id);
+            }
+            std::vector<routingblocks::VertexID> vertices(stations);
+            for (const auto& customer : instance.Customers()) {
+                vertices.push_back(customer.id);
+            }
+            // Seed the member selector from the passed generator to decorrelate both selectors.
+            utility::random member_random(random());
+            StationSeedSelector seed_selector(std::move(stations), random);
+            DistanceBasedClusterMemberSelector member_selector(vertices, get_distance,
+                                                               min_radius_factor,
+                                                               max_radius_factor,
+                                                               std::move(member_random));
+            return ClusterRemoval(seed_selector, member_selector);
+        }
+    }  // namespace
+
+    StationVicinityRemoval::StationVicinityRemoval(
+        const routingblocks::Instance& instance,
+        const std::function<resource_t(routingblocks::VertexID, routingblocks::VertexID)>&
+            get_distance,
+        resource_t min_radius_factor, resource_t max_radius_factor, utility::random random)
+        : _cluster_removal(make_station_vicinity_cluster_removal(
+            instance, get_distance, min_radius_factor, max_radius_factor, random)) {}
+
+    std::vector<routingblocks::VertexID> StationVicinityRemoval::apply(
+        routingblocks::Evaluation& evaluation, routingblocks::Solution& sol,
+        size_t numberOfRemovedCustomers) {
+        return _cluster_removal.apply(evaluation, sol, numberOfRemovedCustomers);
+    }
+
+    std::string_view StationVicinityRemoval::name() const { return "StationVicinityRemoval"; }
+
+    bool StationVicinityRemoval::can_apply_to(const routingblocks::Solution& sol) const {
+        return std::any_of(sol.begin(), sol.end(), [](const routingblocks::Route& route) {
+            return std::any_of(route.begin(), route.end(),
+                               [](const auto& node) { return node.vertex().station(); });
+        });
+    }
+
+    std::shared_ptr<routingblocks::destroy_operator> StationVicinityRemoval::clone() const {
+        return std::make_shared<StationVicinityRemoval>(*this);
+    }
+
+    void StationVicinityRemoval::reseed(utility::random& random) {
+        _cluster_removal.reseed(random);
+    }
+
     void RandomInsertion::apply([[maybe_unused]] routingblocks::Evaluation& evaluation,
                                 routingblocks::Solution& sol,
                                 const std::vector<routingblocks::VertexID>& missing_vertices) {
@@ -109,4 +599,161 @@ namespace routingblocks::lns::operators {
     bool RandomInsertion::can_apply_to(const routingblocks::Solution& sol) const { return true; }
 
     std::string_view RandomInsertion::name() const { return "RandomInsertion"; }
+
+    std::shared_ptr<routingblocks::repair_operator> RandomInsertion::clone() const {
+        return std::make_shared<RandomInsertion>(*this);
+    }
+
+    void RandomInsertion::reseed(utility::random& random) {
+        _random = utility::random(random());
+    }
+
+    namespace {
+        // Copies the vertices that are not stations, retaining their order.
+        void collect_non_station_vertices(const routingblocks::Instance& instance,
+                                          const std::vector<routingblocks::VertexID>& vertices,
+                                          std::vector<routingblocks::VertexID>& non_stations) {
+            non_stations.clear();
+            std::copy_if(vertices.begin(), vertices.end(), std::back_inserter(non_stations),
+                         [&instance](routingblocks::VertexID vertex_id) {
+                             return !instance.getVertex(vertex_id).station();
+                         });
+        }
+
+        // Inserts the vertex and updates the cache. Keeps tracking the vertex if it still has to
+        // be inserted elsewhere, i.e., if it was removed several times.
+        template <class Cache>
+        void insert_and_update(routingblocks::Solution& sol, Cache& cache,
+                               const routingblocks::utility::insertion_move& move,
+                               bool stop_tracking) {
+            auto [route_iter, node_iter] = routingblocks::to_iter(move.after_node, sol);
+            sol.insert_vertex_after(route_iter, node_iter, move.vertex_id);
+            if (stop_tracking) {
+                cache.stop_tracking(move.vertex_id);
+            }
+            cache.invalidate_route(*route_iter, move.after_node.route);
+        }
+    }  // namespace
+
+    BestInsertion::BestInsertion(const routingblocks::Instance& instance,
+                                 const MoveSelector& move_selector, size_t number_of_threads)
+        : _instance(&instance),
+          _insertion_cache(instance, number_of_threads),
+          _move_selector(move_selector.clone()) {}
+
+    void BestInsertion::apply(routingblocks::Evaluation& evaluation, routingblocks::Solution& sol,
+                              const std::vector<routingblocks::VertexID>& missing_vertices) {
+        collect_non_station_vertices(*_instance, missing_vertices, _missing_vertices);
+        if (_missing_vertices.empty()) return;
+        if (sol.size() == 0) {
+            throw std::runtime_error("Cannot insert vertices into a solution without routes!");
+        }
+
+        _insertion_cache.rebuild(evaluation, sol, _missing_vertices.begin(),
+                                 _missing_vertices.end());
+        for (auto next_vertex = _missing_vertices.begin(); next_vertex != _missing_vertices.end();
+             ++next_vertex) {
+            // Each route offers one insertion position after every node but the end depot.
+            auto number_of_moves = routingblocks::number_of_nodes(sol, true);
+            const auto move = *std::next(
+                _insertion_cache.best_insertions_for_vertex_begin(*next_vertex),
+                _move_selector->select(number_of_moves));
+            insert_and_update(sol, _insertion_cache, move,
+                              std::find(std::next(next_vertex), _missing_vertices.end(),
+                                        *next_vertex)
+                                  == _missing_vertices.end());
+        }
+    }
+
+    std::string_view BestInsertion::name() const { return "BestInsertion"; }
+
+    bool BestInsertion::can_apply_to([[maybe_unused]] const routingblocks::Solution& sol) const {
+        return true;
+    }
+
+    std::shared_ptr<routingblocks::repair_operator> BestInsertion::clone() const {
+        return std::make_shared<BestInsertion>(*_instance, *_move_selector, number_of_threads());
+    }
+
+    void BestInsertion::reseed(utility::random& random) {
+        _move_selector->reseed(random);
+    }
+
+    RegretInsertion::RegretInsertion(const routingblocks::Instance& instance, size_t k,
+                                     const MoveSelector& vertex_selector,
+                                     size_t number_of_threads)
+        : _instance(&instance),
+          _insertion_cache(instance, number_of_threads),
+          _k(k),
+          _vertex_selector(vertex_selector.clone()) {
+        if (k == 0) {
+            throw std::runtime_error("RegretInsertion: k must be positive.");
+        }
+    }
+
+    void RegretInsertion::apply(routingblocks::Evaluation& evaluation,
+                                routingblocks::Solution& sol,
+                                const std::vector<routingblocks::VertexID>& missing_vertices) {
+        collect_non_station_vertices(*_instance, missing_vertices, _missing_vertices);
+        if (_missing_vertices.empty()) return;
+        if (sol.size() == 0) {
+            throw std::runtime_error("Cannot insert vertices into a solution without routes!");
+        }
+
+        _insertion_cache.rebuild(evaluation, sol, _missing_vertices.begin(),
+                                 _missing_vertices.end());
+        while (!_missing_vertices.empty()) {
+            _ranking.clear();
+            for (size_t i = 0; i < _missing_vertices.size(); ++i) {
+                // Best insertion into each route
+                _route_insertions.clear();
+                for (size_t route_index = 0; route_index < sol.size(); ++route_index) {
+                    if (const auto* move = _insertion_cache.best_insertion_into_route(
+                            _missing_vertices[i], route_index)) {
+                        _route_insertions.push_back(move);
+                    }
+                }
+                assert(!_route_insertions.empty());
+
+                auto k = std::min(_k, _route_insertions.size());
+                std::partial_sort(
+                    _route_insertions.begin(), std::next(_route_insertions.begin(), k),
+                    _route_insertions.end(),
+                    [](const auto* lhs, const auto* rhs) { return *lhs < *rhs; });
+                cost_t regret = 0;
+                for (size_t q = 1; q < k; ++q) {
+                    regret += _route_insertions[q]->delta_cost - _route_insertions[0]->delta_cost;
+                }
+                _ranking.push_back(ranked_vertex{regret, *_route_insertions[0], i});
+            }
+
+            std::stable_sort(_ranking.begin(), _ranking.end(),
+                             [](const ranked_vertex& lhs, const ranked_vertex& rhs) {
+                                 if (lhs.regret != rhs.regret) return lhs.regret > rhs.regret;
+                                 return lhs.best_insertion < rhs.best_insertion;
+                             });
+            const auto& picked = _ranking[_vertex_selector->select(_ranking.size())];
+            auto next_vertex = std::next(_missing_vertices.begin(), picked.index);
+            insert_and_update(sol, _insertion_cache, picked.best_insertion,
+                              std::count(_missing_vertices.begin(), _missing_vertices.end(),
+                                         *next_vertex)
+                                  == 1);
+            _missing_vertices.erase(next_vertex);
+        }
+    }
+
+    std::string_view RegretInsertion::name() const { return "RegretInsertion"; }
+
+    bool RegretInsertion::can_apply_to([[maybe_unused]] const routingblocks::Solution& sol) const {
+        return true;
+    }
+
+    std::shared_ptr<routingblocks::repair_operator> RegretInsertion::clone() const {
+        return std::make_shared<RegretInsertion>(*_instance, _k, *_vertex_selector,
+                                                 number_of_threads());
+    }
+
+    void RegretInsertion::reseed(utility::random& random) {
+        _vertex_selector->reseed(random);
+    }
 }  // namespace routingblocks::lns::operators
\ No newline at end of file
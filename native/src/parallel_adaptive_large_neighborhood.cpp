@@ -0,0 +1,404 @@
+// Copyright (c) 2023 Patrick S. Klein (@libklein)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <routingblocks/parallel_adaptive_large_neighborhood.h>
+#include <routingblocks/utility/thread_pool.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+
+namespace routingblocks {
+    namespace {
+        // Solution published as best known solution. Published solutions are never modified. The
+        // worker that replaces a published solution retires it, and frees it once no worker
+        // protects it anymore.
+        struct published_solution {
+            Solution solution;
+            cost_t cost;
+        };
+
+        // Scores and invocations of each operator collected during a period.
+        struct operator_scores {
+            std::vector<double> scores;
+            std::vector<size_t> invocations;
+
+            explicit operator_scores(size_t number_of_operators)
+                : scores(number_of_operators, 0.), invocations(number_of_operators, 0) {}
+
+            void record(size_t op, double score) {
+                scores[op] += score;
+                ++invocations[op];
+            }
+
+            void add(const operator_scores& other) {
+                for (size_t op = 0; op < scores.size(); ++op) {
+                    scores[op] += other.scores[op];
+                    invocations[op] += other.invocations[op];
+                }
+            }
+
+            void clear() {
+                std::fill(scores.begin(), scores.end(), 0.);
+                std::fill(invocations.begin(), invocations.end(), 0);
+            }
+
+            // Same update rule as utility::adaptive_priority_list::adapt.
+            void adapt(std::vector<double>& weights, double smoothing_factor) const {
+                for (size_t op = 0; op < weights.size(); ++op) {
+                    weights[op] = smoothing_factor
+                                      * (scores[op] / static_cast<double>(
+                                             std::max(size_t(1), invocations[op])))
+                                  + (1.0 - smoothing_factor) * weights[op];
+                }
+            }
+        };
+
+        struct shared_state {
+            // Owns the best known solution.
+            std::atomic<const published_solution*> best_solution;
+            // Published solution each worker currently reads, indexed by worker.
+            std::vector<std::atomic<const published_solution*>> protected_solutions;
+            std::atomic<size_t> next_iteration = 0;
+
+            // Guards the fields below and the operator weights of the search.
+            std::mutex score_mutex;
+            operator_scores destroy_scores;
+            operator_scores repair_scores;
+            // Workers that reported scores since the operator weights were last adapted.
+            std::vector<bool> has_reported;
+            size_t number_of_reported_workers = 0;
+
+            shared_state(std::unique_ptr<published_solution> initial_solution,
+                         size_t number_of_workers, size_t number_of_destroy_ops,
+                         size_t number_of_repair_ops)
+                : best_solution(initial_solution.release()),
+                  protected_solutions(number_of_workers),
+                  destroy_scores(number_of_destroy_ops),
+                  repair_scores(number_of_repair_ops),
+                  has_reported(number_of_workers, false) {}
+
+            shared_state(const shared_state&) = delete;
+            shared_state& operator=(const shared_state&) = delete;
+
+            ~shared_state() { delete best_solution.load(); }
+        };
+
+        struct worker_state {
+            size_t index;
+            utility::random random;
+            std::vector<std::shared_ptr<destroy_operator>> destroy_operators;
+            std::vector<std::shared_ptr<repair_operator>> repair_operators;
+            // Copies of the shared operator weights, refreshed after each period.
+            std::vector<double> destroy_weights;
+            std::vector<double> repair_weights;
+            operator_scores destroy_scores;
+            operator_scores repair_scores;
+            // Solutions this worker replaced as best known solution and has not freed yet.
+            std::vector<std::unique_ptr<const published_solution>> retired_solutions;
+            // Scratch buffer of applicable operators.
+            std::vector<size_t> applicable_operators;
+
+            worker_state(size_t index, utility::random random,
+                         std::vector<std::shared_ptr<destroy_operator>> destroy_operators,
+                         std::vector<std::shared_ptr<repair_operator>> repair_operators)
+                : index(index),
+                  random(std::move(random)),
+                  destroy_operators(std::move(destroy_operators)),
+                  repair_operators(std::move(repair_operators)),
+                  destroy_scores(this->destroy_operators.size()),
+                  repair_scores(this->repair_operators.size()) {}
+        };
+
+        // Clones are reseeded from random so that workers do not replay each other's, or a previous
+        // run's, operator randomness.
+        template <class Operator>
+        std::vector<std::shared_ptr<Operator>> clone_operators(
+            const std::vector<std::shared_ptr<Operator>>& operators, bool share_uncloneable,
+            utility::random& random) {
+            std::vector<std::shared_ptr<Operator>> clones;
+            clones.reserve(operators.size());
+            for (const auto& op : operators) {
+                auto clone = op->clone();
+                if (!clone) {
+                    if (!share_uncloneable) {
+                        throw std::runtime_error("Operator " + std::string(op->name())
+                                                 + " does not support cloning and cannot be used "
+                                                   "by several workers.");
+                    }
+                    clone = op;
+                } else {
+                    clone->reseed(random);
+                }
+                clones.push_back(std::move(clone));
+            }
+            return clones;
+        }
+
+        // Roulette wheel selection among the operators applicable to the solution.
+        template <class Operator>
+        size_t pick_operator(const std::vector<std::shared_ptr<Operator>>& operators,
+                             const std::vector<double>& weights, const Solution& solution,
+                             utility::random& random, std::vector<size_t>& applicable) {
+            applicable.clear();
+            double total_weight = 0.;
+            for (size_t op = 0; op < operators.size(); ++op) {
+                if (operators[op]->can_apply_to(solution)) {
+                    applicable.push_back(op);
+                    total_weight += weights[op];
+                }
+            }
+            if (applicable.empty()) {
+                throw std::runtime_error("No registered operator can be applied to the solution.");
+            }
+            // All weights may decay to zero if operators never score.
+            if (total_weight <= 0.) {
+                return applicable[random.generateInt(size_t(0), applicable.size() - 1)];
+            }
+            double picked = random.uniform(0., total_weight);
+            for (auto op : applicable) {
+                picked -= weights[op];
+                if (picked <= 0.) return op;
+            }
+            return applicable.back();
+        }
+
+        // Loads the best known solution and protects it from being freed until the worker
+        // protects another solution.
+        const published_solution* protect_best_solution(shared_state& shared,
+                                                         const worker_state& worker) {
+            auto& protected_solution = shared.protected_solutions[worker.index];
+            const auto* best = shared.best_solution.load();
+            while (true) {
+                protected_solution.store(best);
+                // Workers check protections only after removing a solution from the slot, so the
+                // protection holds if the solution is still in the slot.
+                const auto* current_best = shared.best_solution.load();
+                if (current_best == best) return best;
+                best = current_best;
+            }
+        }
+
+        // Frees the retired solutions of the worker that no worker protects.
+        void free_retired_solutions(shared_state& shared, worker_state& worker) {
+            std::erase_if(worker.retired_solutions, [&shared](const auto& retired_solution) {
+                return std::none_of(shared.protected_solutions.begin(),
+                                    shared.protected_solutions.end(),
+                                    [&retired_solution](const auto& protected_solution) {
+                                        return protected_solution.load()
+                                               == retired_solution.get();
+                                    });
+            });
+        }
+
+        // Publishes the candidate if it improves on the best known solution. best must be
+        // protected by the worker and is set to the protected best known solution afterwards.
+        // Returns true on success.
+        bool publish_if_better(shared_state& shared, worker_state& worker,
+                               const published_solution*& best, const Solution& candidate,
+                               cost_t cost) {
+            if (cost >= best->cost) return false;
+
+            auto entry = std::make_unique<published_solution>(published_solution{candidate, cost});
+            while (!shared.best_solution.compare_exchange_strong(best, entry.get())) {
+                best = protect_best_solution(shared, worker);
+                if (cost >= best->cost) return false;
+            }
+            // The slot owns the entry now.
+            entry.release();
+            worker.retired_solutions.emplace_back(best);
+            best = protect_best_solution(shared, worker);
+            // Amortizes the scan over the protections of all workers.
+            if (worker.retired_solutions.size() > shared.protected_solutions.size()) {
+                free_retired_solutions(shared, worker);
+            }
+            return true;
+        }
+
+        // Adds the worker's period scores to the shared ones, adapts the shared weights once every
+        // worker has reported, and refreshes the worker's copy of the weights.
+        void report_scores(shared_state& shared, worker_state& worker,
+                           std::vector<double>& destroy_weights,
+                           std::vector<double>& repair_weights,
+                           const parallel_alns_parameters& parameters) {
+            std::lock_guard lock(shared.score_mutex);
+            shared.destroy_scores.add(worker.destroy_scores);
+            shared.repair_scores.add(worker.repair_scores);
+            worker.destroy_scores.clear();
+            worker.repair_scores.clear();
+            if (!shared.has_reported[worker.index]) {
+                shared.has_reported[worker.index] = true;
+                ++shared.number_of_reported_workers;
+            }
+            if (shared.number_of_reported_workers == parameters.number_of_workers) {
+                shared.destroy_scores.adapt(destroy_weights, parameters.smoothing_factor);
+                shared.repair_scores.adapt(repair_weights, parameters.smoothing_factor);
+                shared.destroy_scores.clear();
+                shared.repair_scores.clear();
+                std::fill(shared.has_reported.begin(), shared.has_reported.end(), false);
+                shared.number_of_reported_workers = 0;
+            }
+            worker.destroy_weights = destroy_weights;
+            worker.repair_weights = repair_weights;
+        }
+
+        void run_worker(Evaluation& evaluation, shared_state& shared, worker_state& worker,
+                        std::vector<double>& destroy_weights, std::vector<double>& repair_weights,
+                        const parallel_alns_parameters& parameters) {
+            {
+                std::lock_guard lock(shared.score_mutex);
+                worker.destroy_weights = destroy_weights;
+                worker.repair_weights = repair_weights;
+            }
+
+            const auto* best = protect_best_solution(shared, worker);
+            Solution current = best->solution;
+            cost_t current_cost = best->cost;
+            size_t iterations_in_period = 0;
+
+            while (shared.next_iteration.fetch_add(1, std::memory_order_relaxed)
+                   < parameters.number_of_iterations) {
+                // Restart from the best known solution once the current one is no longer
+                // acceptable.
+                best = protect_best_solution(shared, worker);
+                if (current_cost > best->cost * (1. + parameters.acceptance_threshold)) {
+                    current = best->solution;
+                    current_cost = best->cost;
+                }
+
+                Solution candidate = current;
+                const auto number_of_vertices = number_of_nodes(candidate);
+                const auto number_of_removed_vertices = std::min(
+                    number_of_vertices,
+                    static_cast<size_t>(std::lround(
+                        worker.random.uniform(parameters.min_removal_factor,
+                                              std::nextafter(parameters.max_removal_factor, 2.))
+                        * static_cast<double>(number_of_vertices))));
+
+                const auto destroy_op
+                    = pick_operator(worker.destroy_operators, worker.destroy_weights, candidate,
+                                    worker.random, worker.applicable_operators);
+                auto removed_vertices = worker.destroy_operators[destroy_op]->apply(
+                    evaluation, candidate, number_of_removed_vertices);
+                const auto repair_op
+                    = pick_operator(worker.repair_operators, worker.repair_weights, candidate,
+                                    worker.random, worker.applicable_operators);
+                worker.repair_operators[repair_op]->apply(evaluation, candidate, removed_vertices);
+
+                const auto candidate_cost = candidate.cost();
+                double score = 0.;
+                if (publish_if_better(shared, worker, best, candidate, candidate_cost)) {
+                    score = parameters.new_best_score;
+                } else if (candidate_cost < current_cost) {
+                    score = parameters.improvement_score;
+                } else if (candidate_cost
+                           <= best->cost * (1. + parameters.acceptance_threshold)) {
+                    score = parameters.acceptance_score;
+                }
+                if (score > 0.) {
+                    current = std::move(candidate);
+                    current_cost = candidate_cost;
+                }
+
+                worker.destroy_scores.record(destroy_op, score);
+                worker.repair_scores.record(repair_op, score);
+                if (++iterations_in_period == parameters.period_length) {
+                    report_scores(shared, worker, destroy_weights, repair_weights, parameters);
+                    iterations_in_period = 0;
+                }
+            }
+            shared.protected_solutions[worker.index].store(nullptr);
+        }
+    }  // namespace
+
+    parallel_adaptive_large_neighborhood::parallel_adaptive_large_neighborhood(
+        utility::random random, parallel_alns_parameters parameters)
+        : _random(std::move(random)), _parameters(parameters) {
+        if (_parameters.number_of_workers == 0) {
+            throw std::runtime_error("Parallel ALNS requires at least one worker.");
+        }
+        if (_parameters.period_length == 0) {
+            throw std::runtime_error("Parallel ALNS requires a positive period length.");
+        }
+        if (_parameters.min_removal_factor < 0.
+            || _parameters.min_removal_factor > _parameters.max_removal_factor
+            || _parameters.max_removal_factor > 1.) {
+            throw std::runtime_error(
+                "Parallel ALNS requires 0 <= min_removal_factor <= max_removal_factor <= 1.");
+        }
+    }
+
+    void parallel_adaptive_large_neighborhood::add_operator(std::shared_ptr<destroy_operator> op) {
+        _destroy_operators.push_back(std::move(op));
+        _destroy_operator_weights.push_back(1.0);
+    }
+
+    void parallel_adaptive_large_neighborhood::add_operator(std::shared_ptr<repair_operator> op) {
+        _repair_operators.push_back(std::move(op));
+        _repair_operator_weights.push_back(1.0);
+    }
+
+    void parallel_adaptive_large_neighborhood::reset_operator_weights() {
+        std::fill(_destroy_operator_weights.begin(), _destroy_operator_weights.end(), 1.0);
+        std::fill(_repair_operator_weights.begin(), _repair_operator_weights.end(), 1.0);
+    }
+
+    Solution parallel_adaptive_large_neighborhood::optimize(Evaluation& evaluation,
+                                                            const Solution& initial_solution) {
+        if (_destroy_operators.empty() || _repair_operators.empty()) {
+            throw std::runtime_error(
+                "Tried to generate a neighbourhood without any operators registered");
+        }
+
+        shared_state shared(std::make_unique<published_solution>(
+                                published_solution{initial_solution, initial_solution.cost()}),
+                            _parameters.number_of_workers, _destroy_operators.size(),
+                            _repair_operators.size());
+
+        // Workers are set up on the calling thread, so only cloning needs to be thread-safe.
+        const bool single_worker = _parameters.number_of_workers == 1;
+        std::vector<worker_state> workers;
+        workers.reserve(_parameters.number_of_workers);
+        for (size_t i = 0; i < _parameters.number_of_workers; ++i) {
+            utility::random random(_random());
+            auto destroy_operators = clone_operators(_destroy_operators, single_worker, random);
+            auto repair_operators = clone_operators(_repair_operators, single_worker, random);
+            workers.emplace_back(i, std::move(random), std::move(destroy_operators),
+                                 std::move(repair_operators));
+        }
+
+        utility::thread_pool pool(_parameters.number_of_workers);
+        pool.parallel_for(workers.size(), [&](size_t i) {
+            try {
+                run_worker(evaluation, shared, workers[i], _destroy_operator_weights,
+                           _repair_operator_weights, _parameters);
+            } catch (...) {
+                // Stop the remaining workers.
+                shared.next_iteration.store(_parameters.number_of_iterations,
+                                            std::memory_order_relaxed);
+                throw;
+            }
+        });
+
+        return shared.best_solution.load()->solution;
+    }
+}  // namespace routingblocks
@@ -18,4 +18,16 @@
 # CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 from .._routingblocks import ADPTWEvaluation as Evaluation, ADPTWArcData as ArcData, ADPTWVertexData as VertexData, \
-    create_adptw_arc, create_adptw_vertex, ADPTWFacilityPlacementOptimizer as FacilityPlacementOptimizer
+    create_adptw_arc, create_adptw_vertex, \
+    build_adptw_distance_relatedness_matrix as build_distance_relatedness_matrix, \
+    build_adptw_spatio_temporal_relatedness_matrix as build_spatio_temporal_relatedness_matrix, \
+    build_adptw_shaw_relatedness_matrix as build_shaw_relatedness_matrix, \
+    ADPTWFacilityPlacementOptimizer as FacilityPlacementOptimizer, \
+    ADPTWBatchFacilityPlacementOptimizer as BatchFacilityPlacementOptimizer, \
+    ADPTWTypedRoute as TypedRoute, \
+    ADPTWSwapOperator_0_1 as SwapOperator_0_1, ADPTWSwapOperator_0_2 as SwapOperator_0_2, \
+    ADPTWSwapOperator_0_3 as SwapOperator_0_3, ADPTWSwapOperator_1_1 as SwapOperator_1_1, \
+    ADPTWSwapOperator_1_2 as SwapOperator_1_2, ADPTWSwapOperator_1_3 as SwapOperator_1_3, \
+    ADPTWSwapOperator_2_1 as SwapOperator_2_1, ADPTWSwapOperator_2_2 as SwapOperator_2_2, \
+    ADPTWSwapOperator_2_3 as SwapOperator_2_3, ADPTWSwapOperator_3_1 as SwapOperator_3_1, \
+    ADPTWSwapOperator_3_2 as SwapOperator_3_2, ADPTWSwapOperator_3_3 as SwapOperator_3_3
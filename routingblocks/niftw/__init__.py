@@ -18,4 +18,16 @@
 # CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 from .._routingblocks import NIFTWEvaluation as Evaluation, NIFTWArcData as ArcData, NIFTWVertexData as VertexData, \
-    NIFTWFacilityPlacementOptimizer as FacilityPlacementOptimizer, create_niftw_arc, create_niftw_vertex
+    NIFTWFacilityPlacementOptimizer as FacilityPlacementOptimizer, \
+    NIFTWBidirectionalFacilityPlacementOptimizer as BidirectionalFacilityPlacementOptimizer, \
+    NIFTWBatchFacilityPlacementOptimizer as BatchFacilityPlacementOptimizer, create_niftw_arc, create_niftw_vertex, \
+    build_niftw_distance_relatedness_matrix as build_distance_relatedness_matrix, \
+    build_niftw_spatio_temporal_relatedness_matrix as build_spatio_temporal_relatedness_matrix, \
+    build_niftw_shaw_relatedness_matrix as build_shaw_relatedness_matrix, \
+    NIFTWTypedRoute as TypedRoute, \
+    NIFTWSwapOperator_0_1 as SwapOperator_0_1, NIFTWSwapOperator_0_2 as SwapOperator_0_2, \
+    NIFTWSwapOperator_0_3 as SwapOperator_0_3, NIFTWSwapOperator_1_1 as SwapOperator_1_1, \
+    NIFTWSwapOperator_1_2 as SwapOperator_1_2, NIFTWSwapOperator_1_3 as SwapOperator_1_3, \
+    NIFTWSwapOperator_2_1 as SwapOperator_2_1, NIFTWSwapOperator_2_2 as SwapOperator_2_2, \
+    NIFTWSwapOperator_2_3 as SwapOperator_2_3, NIFTWSwapOperator_3_1 as SwapOperator_3_1, \
+    NIFTWSwapOperator_3_2 as SwapOperator_3_2, NIFTWSwapOperator_3_3 as SwapOperator_3_3
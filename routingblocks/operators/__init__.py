@@ -29,4 +29,20 @@ from .related_removal import RelatedRemovalOperator, MoveSelector, RelatedVertex
     build_relatedness_matrix
 from .._routingblocks import _RandomRemovalOperator as RandomRemovalOperator, \
     _RandomInsertionOperator as RandomInsertionOperator
+from .._routingblocks import _MoveSelector as NativeMoveSelector, \
+    _FirstMoveSelector as NativeFirstMoveSelector, \
+    _LastMoveSelector as NativeLastMoveSelector, \
+    _NthMoveSelector as NativeNthMoveSelector, \
+    _BlinkMoveSelector as NativeBlinkMoveSelector, \
+    _RandomMoveSelector as NativeRandomMoveSelector, \
+    _SeedSelector as NativeSeedSelector, \
+    _StationSeedSelector as NativeStationSeedSelector, \
+    _ClusterMemberSelector as NativeClusterMemberSelector, \
+    _DistanceBasedClusterMemberSelector as NativeDistanceBasedClusterMemberSelector, \
+    _RelatedRemovalOperator as NativeRelatedRemovalOperator, \
+    _WorstRemovalOperator as NativeWorstRemovalOperator, \
+    _ClusterRemovalOperator as NativeClusterRemovalOperator, \
+    _StationVicinityRemovalOperator as NativeStationVicinityRemovalOperator, \
+    _BestInsertionOperator as NativeBestInsertionOperator, \
+    _RegretInsertionOperator as NativeRegretInsertionOperator
 from .._routingblocks.operators import *
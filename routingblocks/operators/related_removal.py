@@ -18,7 +18,7 @@
 # CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 from __future__ import annotations
-from typing import List, Callable, Set, Tuple
+from typing import List, Callable, Set, Tuple, Union
 
 from .move_selectors import MoveSelector
 from dataclasses import dataclass
@@ -55,6 +55,11 @@ def build_relatedness_matrix(instance: routingblocks.Instance, relatedness_compu
     :param instance: The instance.
     :param relatedness_computer: A function that computes the relatedness between two vertices. Takes as input the ids of the two vertices and returns a number that measures the degree of relatedness.
     :return: A matrix of relatedness values.
+
+    .. note::
+        Calls :param relatedness_computer once for each pair of vertices. The ADPTW and NIFTW specializations provide
+        native builders for common relatedness measures, e.g., :py:func:`routingblocks.adptw.build_shaw_relatedness_matrix`,
+        which are much faster on large instances.
     """
     matrix: List[List[float]] = []
     n = instance.number_of_vertices
@@ -80,14 +85,14 @@ class RelatedRemovalOperator(routingblocks.DestroyOperator):
     (Initial) seed and related vertex selection is done using move selectors.
     """
 
-    def __init__(self, relatedness_matrix: List[List[float]],
+    def __init__(self, relatedness_matrix: Union[List[List[float]], routingblocks.RelatednessMatrix],
                  move_selector: MoveSelector[RelatedVertexRemovalMove],
                  seed_selector: MoveSelector[RelatedVertexRemovalMove],
                  initial_seed_selector: MoveSelector[routingblocks.Node],
                  cluster_size: int = 1):
         """
 
-        :param relatedness_matrix: The relatedness matrix. See :py:func:`build_relatedness_matrix` for a way to build such a matrix.
+        :param relatedness_matrix: The relatedness matrix. See :py:func:`build_relatedness_matrix` for a way to build such a matrix. Accepts a native :py:class:`routingblocks.RelatednessMatrix` as well.
         :param move_selector: The move selector to use for selecting the vertex to remove. Receives a list of related vertices, ordered by the degree of relatedness in descending order.
         :param seed_selector: The move selector to use for selecting the seed vertex.
         :param initial_seed_selector: The move selector to use for selecting the initial seed vertex.
@@ -0,0 +1,76 @@
+# Copyright (c) 2023 Patrick S. Klein (@libklein)
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy of
+# this software and associated documentation files (the "Software"), to deal in
+# the Software without restriction, including without limitation the rights to
+# use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+# the Software, and to permit persons to whom the Software is furnished to do so,
+# subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+# FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+# COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+# IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+# CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+import pytest
+
+import routingblocks
+from routingblocks.operators import BestInsertionOperator, NativeBestInsertionOperator, \
+    NativeRegretInsertionOperator, first_move_selector, last_move_selector, NativeFirstMoveSelector, \
+    NativeLastMoveSelector
+from fixtures import *
+
+
+@pytest.mark.parametrize('python_selector,native_selector', [
+    (first_move_selector, NativeFirstMoveSelector()),
+    (last_move_selector, NativeLastMoveSelector()),
+])
+def test_native_best_insertion(instance, mock_evaluation, python_selector, native_selector):
+    _, instance = instance
+    raw_routes = [[1, 3], [5], []]
+    missing_vertices = [4, 2]
+    python_solution = create_solution(instance, mock_evaluation, raw_routes)
+    native_solution = create_solution(instance, mock_evaluation, raw_routes)
+
+    BestInsertionOperator(instance, python_selector).apply(mock_evaluation, python_solution, missing_vertices)
+    NativeBestInsertionOperator(instance, native_selector).apply(mock_evaluation, native_solution,
+                                                                 missing_vertices)
+    assert native_solution == python_solution
+
+
+@pytest.mark.parametrize('k', [1, 2, 3])
+def test_native_regret_insertion(instance, mock_evaluation, k):
+    _, instance = instance
+    raw_routes = [[1, 3], [5], []]
+    missing_vertices = [4, 2, 6]
+    solution = create_solution(instance, mock_evaluation, raw_routes)
+
+    NativeRegretInsertionOperator(instance, k=k).apply(mock_evaluation, solution, missing_vertices)
+    # Stations are not inserted
+    assert sorted(node.vertex_id for route in solution for node in route if not node.vertex.is_depot) \
+           == [1, 2, 3, 4, 5]
+
+    if k == 1:
+        # Regret-1 is greedy cheapest insertion
+        expected_solution = create_solution(instance, mock_evaluation, raw_routes)
+        cache = routingblocks.InsertionCache(instance)
+        cache.rebuild(mock_evaluation, expected_solution, [4, 2])
+        for _ in range(2):
+            move = cache.moves_in_order[0]
+            expected_solution.insert_vertex_after(move.after_node, move.vertex_id)
+            cache.stop_tracking(move.vertex_id)
+            cache.invalidate_route(expected_solution[move.after_node.route], move.after_node.route)
+        assert solution.cost == pytest.approx(expected_solution.cost)
+
+
+def test_native_best_insertion_threads_reject_python_evaluation(instance, mock_evaluation):
+    _, instance = instance
+    solution = create_solution(instance, mock_evaluation, [[1, 3], [5]])
+    operator = NativeBestInsertionOperator(instance, NativeFirstMoveSelector(), number_of_threads=2)
+    with pytest.raises(RuntimeError):
+        operator.apply(mock_evaluation, solution, [4, 2])
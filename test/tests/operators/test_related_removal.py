@@ -22,7 +22,8 @@ import math
 import pytest
 
 import routingblocks
-from routingblocks.operators.related_removal import RelatedVertexRemovalMove, RelatedRemovalOperator
+from routingblocks.operators.related_removal import RelatedVertexRemovalMove, RelatedRemovalOperator, \
+    build_relatedness_matrix
 from fixtures import *
 
 
@@ -114,3 +115,83 @@ def test_related_remove(instance, mock_evaluation, cluster_size, raw_routes, exp
     assert mock_seed_selector.num_calls == math.ceil((len(expected_moves) - 1) / cluster_size)
     # Move selector should be classed once for each vertex to remove except the first one
     assert mock_move_selector.calls == len(expected_moves) - 1
+
+
+def test_relatedness_matrix(instance):
+    _, instance = instance
+    n = instance.number_of_vertices
+    matrix = [[float((i * 7 + j * 3) % 11) for j in range(n)] for i in range(n)]
+
+    relatedness_matrix = routingblocks.RelatednessMatrix(matrix, number_of_neighbors=3)
+    assert len(relatedness_matrix) == n
+    assert relatedness_matrix.number_of_neighbors == 3
+    for i in range(n):
+        assert relatedness_matrix[i] == pytest.approx(matrix[i])
+        # Ties are broken by vertex id
+        expected_neighbors = sorted((j for j in range(n) if j != i), key=lambda j: (-matrix[i][j], j))[:3]
+        assert relatedness_matrix.neighbors(i) == expected_neighbors
+
+    with pytest.raises(IndexError):
+        relatedness_matrix[n]
+    with pytest.raises(IndexError):
+        relatedness_matrix.relatedness(0, n)
+    with pytest.raises(IndexError):
+        relatedness_matrix.relatedness(n, 0)
+    with pytest.raises(IndexError):
+        relatedness_matrix.neighbors(n)
+
+
+def test_build_spatio_temporal_relatedness_matrix(instance):
+    py_instance, instance = instance
+    py_vertices = [py_instance.vertices[x.str_id] for x in instance]
+
+    def relatedness(i: int, j: int) -> float:
+        vertex_i, vertex_j = py_vertices[i], py_vertices[j]
+        t_ij = py_instance.arcs[vertex_i.vertex_id, vertex_j.vertex_id].travel_time
+        inverse_relatedness = t_ij \
+                              + max(0., vertex_j.ready_time - vertex_i.service_time - t_ij - vertex_i.ready_time) * 0.5 \
+                              + max(0., vertex_i.ready_time + vertex_i.service_time + t_ij - vertex_j.due_date) * 2.
+        # Coinciding vertices are maximally related, i.e., get the largest single precision float
+        return 1. / inverse_relatedness if inverse_relatedness != 0. else 3.4028234663852886e+38
+
+    expected_matrix = build_relatedness_matrix(instance, relatedness)
+    relatedness_matrix = routingblocks.adptw.build_spatio_temporal_relatedness_matrix(
+        instance, slack_weight=0.5, tw_shift_weight=2., number_of_neighbors=instance.number_of_vertices)
+    assert relatedness_matrix.number_of_neighbors == instance.number_of_vertices - 1
+    for i in range(instance.number_of_vertices):
+        assert relatedness_matrix[i] == pytest.approx(expected_matrix[i], rel=1e-5)
+        neighbors = relatedness_matrix.neighbors(i)
+        assert sorted(neighbors) == [j for j in range(instance.number_of_vertices) if j != i]
+        assert all(relatedness_matrix.relatedness(i, a) >= relatedness_matrix.relatedness(i, b)
+                   for a, b in zip(neighbors, neighbors[1:]))
+
+
+@pytest.mark.parametrize('cluster_size', [1, 2])
+# Short neighbor lists and selectors picking late moves exercise the fallback to all remaining vertices
+@pytest.mark.parametrize('number_of_neighbors', [1, 3])
+@pytest.mark.parametrize('move_selector,native_move_selector', [
+    (routingblocks.operators.first_move_selector, routingblocks.operators.NativeFirstMoveSelector),
+    (routingblocks.operators.last_move_selector, routingblocks.operators.NativeLastMoveSelector),
+])
+def test_native_related_removal(instance, mock_evaluation, cluster_size, number_of_neighbors, move_selector,
+                                native_move_selector):
+    _, instance = instance
+    raw_routes = [[1, 2], [3, 4, 5], []]
+    n = instance.number_of_vertices
+    matrix = [[float((i * 7 + j * 3) % 11) for j in range(n)] for i in range(n)]
+
+    python_operator = RelatedRemovalOperator(matrix, move_selector,
+                                             routingblocks.operators.last_move_selector,
+                                             routingblocks.operators.nth_move_selector_factory(2),
+                                             cluster_size=cluster_size)
+    native_operator = routingblocks.operators.NativeRelatedRemovalOperator(
+        routingblocks.RelatednessMatrix(matrix, number_of_neighbors=number_of_neighbors),
+        native_move_selector(), routingblocks.operators.NativeLastMoveSelector(),
+        routingblocks.operators.NativeNthMoveSelector(2), cluster_size=cluster_size)
+
+    for number_of_removed_vertices in range(1, 6):
+        python_solution = create_solution(instance, mock_evaluation, raw_routes)
+        native_solution = create_solution(instance, mock_evaluation, raw_routes)
+        assert native_operator.apply(mock_evaluation, native_solution, number_of_removed_vertices) \
+               == python_operator.apply(mock_evaluation, python_solution, number_of_removed_vertices)
+        assert native_solution == python_solution
@@ -82,3 +82,25 @@ def test_station_vicinity_removal(instance, mock_evaluation, randgen, raw_routes
                         :num_removed_vertices]
     assert len(removed_vertices) == len(expected_vertices)
     assert set(x.vertex_id for x in expected_vertices) == set(removed_vertices)
+
+
+@pytest.mark.parametrize('raw_routes,num_removed_vertices', [
+    ([[1, 2, 3], [4, 5, 6]], 3),
+    ([[1, 2, 3], [4, 5]], 0),
+])
+def test_native_station_vicinity_removal(instance, mock_evaluation, randgen, raw_routes, num_removed_vertices):
+    py_instance, instance = instance
+
+    solution = create_solution(instance, mock_evaluation, raw_routes)
+    station_vicinity_operator = routingblocks.operators.NativeStationVicinityRemovalOperator(
+        instance, get_distance=lambda x, y: py_instance.arcs[x.str_id, y.str_id].distance,
+        min_radius_factor=1., max_radius_factor=1., random=randgen)
+    assert station_vicinity_operator.can_apply_to(solution) == (num_removed_vertices > 0)
+
+    removed_vertices = station_vicinity_operator.apply(mock_evaluation, solution, num_removed_vertices)
+
+    picked_station = instance.get_vertex(6)
+    expected_vertices = sorted([x for x in list(instance.customers) + list(instance.stations)],
+                               key=lambda x: py_instance.arcs[picked_station.str_id, x.str_id].distance)[
+                        :num_removed_vertices]
+    assert set(x.vertex_id for x in expected_vertices) == set(removed_vertices)
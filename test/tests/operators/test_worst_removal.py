@@ -0,0 +1,46 @@
+# Copyright (c) 2023 Patrick S. Klein (@libklein)
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy of
+# this software and associated documentation files (the "Software"), to deal in
+# the Software without restriction, including without limitation the rights to
+# use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+# the Software, and to permit persons to whom the Software is furnished to do so,
+# subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+# FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+# COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+# IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+# CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+import pytest
+
+import routingblocks
+from routingblocks.operators import WorstRemovalOperator, NativeWorstRemovalOperator, first_move_selector, \
+    last_move_selector, NativeFirstMoveSelector, NativeLastMoveSelector
+from fixtures import *
+
+
+@pytest.mark.parametrize('python_selector,native_selector', [
+    (first_move_selector, NativeFirstMoveSelector()),
+    (last_move_selector, NativeLastMoveSelector()),
+])
+def test_native_worst_removal(instance, mock_evaluation, python_selector, native_selector):
+    _, instance = instance
+    raw_routes = [[1, 2, 3], [4, 5, 6]]
+    python_operator = WorstRemovalOperator(instance, python_selector)
+    native_operator = NativeWorstRemovalOperator(instance, native_selector)
+
+    for number_of_removed_vertices in range(0, 7):
+        python_solution = create_solution(instance, mock_evaluation, raw_routes)
+        native_solution = create_solution(instance, mock_evaluation, raw_routes)
+        assert native_operator.apply(mock_evaluation, native_solution, number_of_removed_vertices) \
+               == python_operator.apply(mock_evaluation, python_solution, number_of_removed_vertices)
+        assert native_solution == python_solution
+
+    with pytest.raises(RuntimeError):
+        native_operator.apply(mock_evaluation, create_solution(instance, mock_evaluation, raw_routes), 7)
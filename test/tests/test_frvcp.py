@@ -20,6 +20,7 @@
 from __future__ import annotations
 
 import time
+from concurrent.futures import ThreadPoolExecutor
 from typing import Tuple, Callable, Dict, List, Iterable, Optional
 
 import pytest
@@ -34,6 +35,7 @@ import sys
 try:
     import routingblocks as evrptw
     from routingblocks import adptw
+    from routingblocks import niftw
 
 
     class MockLabel:
@@ -151,3 +153,127 @@ def test_facility_placement_optimizer_custom_propagator(adptw_instance):
     facility_placement_optimizer = evrptw.FacilityPlacementOptimizer(adptw_instance, MockPropagator())
     route = [0, 1, 0]
     facility_placement_optimizer.optimize(route)
+
+
+@pytest.mark.parametrize("number_of_threads", [1, 4])
+def test_batch_facility_placement_optimizer(large_instance, number_of_threads):
+    py_instance, instance = large_instance
+    customers = [x.vertex_id for x in instance.customers]
+    evaluation = adptw.Evaluation(py_instance.parameters.battery_capacity_time,
+                                  py_instance.parameters.capacity)
+
+    random.seed(1)
+    routes = [[0, *random.sample(customers, k=random.randint(1, 10)), 0] for _ in range(20)]
+    facility_placement_optimizer = adptw.FacilityPlacementOptimizer(instance,
+                                                                    py_instance.parameters.battery_capacity_time)
+    expected_routes = [facility_placement_optimizer.optimize(route) for route in routes]
+
+    batch_optimizer = adptw.BatchFacilityPlacementOptimizer(instance, py_instance.parameters.battery_capacity_time,
+                                                            number_of_threads=number_of_threads)
+    assert batch_optimizer.number_of_threads == number_of_threads
+    assert batch_optimizer.optimize(routes) == expected_routes
+
+    solution = evrptw.Solution(evaluation, instance,
+                               [evrptw.create_route(evaluation, instance, route[1:-1]) for route in routes])
+    assert batch_optimizer.optimize(solution) == expected_routes
+
+
+def test_batch_facility_placement_optimizer_concurrent_calls(large_instance):
+    py_instance, instance = large_instance
+    customers = [x.vertex_id for x in instance.customers]
+
+    random.seed(1)
+    routes = [[0, *random.sample(customers, k=random.randint(1, 10)), 0] for _ in range(20)]
+    batch_optimizer = adptw.BatchFacilityPlacementOptimizer(instance, py_instance.parameters.battery_capacity_time,
+                                                            number_of_threads=4)
+    expected_routes = batch_optimizer.optimize(routes)
+
+    # optimize releases the GIL, so several python threads may call it on the same object at once
+    with ThreadPoolExecutor(max_workers=4) as executor:
+        results = list(executor.map(lambda _: batch_optimizer.optimize(routes), range(8)))
+    assert all(result == expected_routes for result in results)
+
+
+def test_facility_placement_optimizer_cache(large_instance):
+    py_instance, instance = large_instance
+    customers = [x.vertex_id for x in instance.customers]
+    stations = [x.vertex_id for x in instance.stations]
+
+    random.seed(1)
+    routes = [[0, *random.sample(customers, k=random.randint(1, 10)), 0] for _ in range(10)]
+    facility_placement_optimizer = adptw.FacilityPlacementOptimizer(instance,
+                                                                    py_instance.parameters.battery_capacity_time)
+    expected_routes = [facility_placement_optimizer.optimize(route) for route in routes]
+    assert facility_placement_optimizer.cache_capacity == 0
+
+    cached_optimizer = adptw.FacilityPlacementOptimizer(instance, py_instance.parameters.battery_capacity_time,
+                                                        cache_capacity=len(routes))
+    assert [cached_optimizer.optimize(route) for route in routes] == expected_routes
+    assert cached_optimizer.cache_hits == 0
+    assert cached_optimizer.cache_misses == len(routes)
+
+    # Stations do not change the customer sequence
+    routes_with_stations = [[route[0], random.choice(stations), *route[1:]] for route in routes]
+    assert [cached_optimizer.optimize(route) for route in routes_with_stations] \
+           == [facility_placement_optimizer.optimize(route) for route in routes_with_stations]
+    assert cached_optimizer.cache_hits == len(routes)
+    assert cached_optimizer.cache_misses == len(routes)
+
+    cached_optimizer.clear_cache()
+    assert cached_optimizer.optimize(routes[0]) == expected_routes[0]
+    assert cached_optimizer.cache_misses == len(routes) + 1
+
+
+@pytest.mark.parametrize("customer_due_date,expected_route", [(1000., [0, 2, 1, 2, 0]), (9., [0, 1, 0])])
+def test_niftw_facility_placement_optimizer(customer_due_date, expected_route):
+    # Depot 0, customer 1 and station 2. Coordinates do not match the arcs on purpose.
+    vertices = [niftw.create_niftw_vertex(0, "D0", False, True, niftw.VertexData(0., 0., 0., 0., 1000., 0.)),
+                niftw.create_niftw_vertex(1, "C1", False, False,
+                                          niftw.VertexData(1., 1., 0., 0., customer_due_date, 0.)),
+                niftw.create_niftw_vertex(2, "S2", True, False, niftw.VertexData(2., 2., 0., 0., 1000., 0.))]
+    distances = [[0., 8., 6.], [8., 0., 5.], [3., 4., 0.]]
+    arcs = [[niftw.create_niftw_arc(niftw.ArcData(d, d, d)) for d in row] for row in distances]
+    instance = evrptw.Instance(vertices, arcs, 1)
+    optimizer = niftw.FacilityPlacementOptimizer(instance, 10., 1.)
+    # With a battery capacity of 10, 0-1-0 (16) and 0-1-2-0 (8 + 5 before the station) run out of charge, and so
+    # does 0-2-1-0 (4 + 8 after the station). 0-2-1-2-0 consumes 6, 4 + 5 and 3 between replenishments and reaches
+    # the customer at 6 + 4 + 1 = 11, i.e., it is feasible only if the customer's due date is at least 11.
+    assert optimizer.optimize([0, 1, 0]) == expected_route
+
+
+def test_niftw_bidirectional_facility_placement_optimizer(large_instance):
+    py_instance, instance = large_instance
+    battery_capacity_time = py_instance.parameters.battery_capacity_time
+    replenishment_time = 10.
+    facility_placement_optimizer = niftw.FacilityPlacementOptimizer(instance, battery_capacity_time,
+                                                                    replenishment_time)
+    bidirectional_optimizer = niftw.BidirectionalFacilityPlacementOptimizer(instance, battery_capacity_time,
+                                                                            replenishment_time)
+
+    def py_vertex(vertex_id):
+        return py_instance.vertices[instance.get_vertex(vertex_id).str_id]
+
+    def cost(route):
+        return sum(py_instance.arcs[py_vertex(u).vertex_id, py_vertex(v).vertex_id].cost
+                   for u, v in zip(route, route[1:]))
+
+    random.seed(1)
+    customers = [x.vertex_id for x in instance.customers]
+    # Labels created on routes that require replenishment
+    number_of_labels = 0
+    number_of_bidirectional_labels = 0
+    for _ in range(100):
+        # Order customers by their time windows so that some routes are feasible
+        picked_customers = sorted(random.sample(customers, k=random.randint(1, 10)),
+                                  key=lambda x: py_vertex(x).ready_time)
+        route = [0, *picked_customers, 0]
+        expected_route = facility_placement_optimizer.optimize(route)
+        optimized_route = bidirectional_optimizer.optimize(route)
+        if expected_route != route:
+            number_of_labels += facility_placement_optimizer.number_of_labels
+            number_of_bidirectional_labels += bidirectional_optimizer.number_of_labels
+        # Stations may be placed differently on routes of equal cost
+        if optimized_route != expected_route:
+            assert [x for x in optimized_route if not instance.get_vertex(x).is_station] == route
+            assert cost(optimized_route) == pytest.approx(cost(expected_route))
+    assert number_of_bidirectional_labels < number_of_labels
@@ -90,6 +90,8 @@ def test_insertion_cache(instance, raw_routes, vertices_to_insert, expected_numb
             assert not cache.tracks_vertex(vertex_id)
     # Ensure that the right vertices are tracked
     assert set(cache.tracked_vertices) == set(vertices_to_insert)
+    # Ensure that the joint move list covers every tracked vertex
+    assert len(cache.moves_in_order) == len(vertices_to_insert) * expected_number_of_locations
     # Ensure that moves are sorted correctly
     assert all(
         pred.delta_cost <= succ.delta_cost for pred, succ in
@@ -165,3 +167,40 @@ def test_insertion_cache_update(instance, vertices_to_insert, raw_routes):
         cache.invalidate_route(solution[insertion_point.route], insertion_point.route)
         expected_cache.rebuild(evaluation, solution, vertices_to_insert)
         assert_cache_equal(instance=instance, solution=solution, cache1=cache, cache2=expected_cache)
+
+
+@pytest.mark.parametrize("raw_routes,vertices_to_insert", [
+    ([[1, 6, 3], [8, 2, 7]], [4, 5]),
+    ([[2, 6, 3], [], [8, 1], []], [4, 5, 7])
+])
+def test_insertion_cache_parallel(instance, raw_routes, vertices_to_insert):
+    py_instance, instance = instance
+    evaluation = niftw.Evaluation(py_instance.parameters.battery_capacity_time, py_instance.parameters.capacity,
+                                  0.0)
+
+    expected_cache = InsertionCache(instance)
+    cache = InsertionCache(instance, number_of_threads=4)
+    assert cache.number_of_threads == 4
+
+    solution = build_solution(evaluation, instance, raw_routes)
+
+    cache.rebuild(evaluation, solution, vertices_to_insert)
+    expected_cache.rebuild(evaluation, solution, vertices_to_insert)
+    assert_cache_equal(instance=instance, solution=solution, cache1=cache, cache2=expected_cache)
+
+    while len(vertices_to_insert) > 0:
+        vertex_id = vertices_to_insert.pop()
+        insertion_point = alns.NodeLocation(0, 1)
+        solution.insert_vertex_after(insertion_point, vertex_id)
+        for c in (cache, expected_cache):
+            c.stop_tracking(vertex_id)
+            c.invalidate_route(solution[insertion_point.route], insertion_point.route)
+        assert_cache_equal(instance=instance, solution=solution, cache1=cache, cache2=expected_cache)
+
+
+def test_insertion_cache_parallel_rejects_python_evaluation(instance, mock_evaluation):
+    _, instance = instance
+    solution = build_solution(mock_evaluation, instance, [[1, 2, 3]])
+    cache = InsertionCache(instance, number_of_threads=2)
+    with pytest.raises(RuntimeError):
+        cache.rebuild(mock_evaluation, solution, [4, 5])
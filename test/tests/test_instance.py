@@ -121,3 +121,25 @@ def test_overloaded_constructors(depot, customers, stations):
 
     instance2 = Instance(vertices, arcs, 1)
     assert instance2.fleet_size == 1  # Provided fleet_size should be set correctly
+
+
+def test_instance_from_dense_arc_data():
+    from routingblocks import adptw, create_route
+
+    vertices = [adptw.create_adptw_vertex(0, "depot", False, True, adptw.VertexData(0, 0, 0, 0, 1000, 0)),
+                adptw.create_adptw_vertex(1, "customer1", False, False, adptw.VertexData(1, 1, 10, 0, 1000, 1)),
+                adptw.create_adptw_vertex(2, "customer2", False, False, adptw.VertexData(2, 2, 10, 0, 1000, 1)),
+                adptw.create_adptw_vertex(3, "station1", True, False, adptw.VertexData(3, 3, 0, 0, 1000, 0))]
+    arc_data = [[adptw.ArcData(float(i + 2 * j), 1., float(i + 2 * j)) for j in range(len(vertices))]
+                for i in range(len(vertices))]
+
+    dense_instance = Instance(vertices, arc_data, 2)
+    instance = Instance(vertices, [[adptw.create_adptw_arc(data) for data in row] for row in arc_data], 2)
+    assert dense_instance.number_of_vertices == instance.number_of_vertices
+
+    evaluation = adptw.Evaluation(100., 100.)
+    assert create_route(evaluation, dense_instance, [1, 3, 2]).cost == \
+           create_route(evaluation, instance, [1, 3, 2]).cost
+
+    with pytest.raises(RuntimeError):
+        Instance(vertices, [row[:-1] for row in arc_data], 2)
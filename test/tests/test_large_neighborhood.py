@@ -152,3 +152,69 @@ def test_large_neighborhood_remove(randgen):
     large_neighborhood.remove_repair_operator(repair_operator)
     assert list(large_neighborhood.repair_operators) == []
     assert list(large_neighborhood.destroy_operators) == [destroy_operator]
+
+
+def test_parallel_large_neighborhood_empty(instance, mock_evaluation, randgen):
+    _, instance = instance
+    solution = create_solution(instance, mock_evaluation, [[1, 2, 3, 4, 5]])
+    large_neighborhood = evrptw.ParallelAdaptiveLargeNeighborhood(randgen, evrptw.ParallelALNSParameters())
+    with pytest.raises(RuntimeError):
+        large_neighborhood.optimize(mock_evaluation, solution)
+
+    large_neighborhood.add_destroy_operator(evrptw.operators.RandomRemovalOperator(randgen))
+    with pytest.raises(RuntimeError):
+        large_neighborhood.optimize(mock_evaluation, solution)
+
+
+@pytest.mark.parametrize('number_of_workers', [1, 2])
+def test_parallel_large_neighborhood_optimize(instance, randgen, number_of_workers):
+    py_instance, instance = instance
+    evaluation = evrptw.adptw.Evaluation(py_instance.parameters.battery_capacity_time,
+                                         py_instance.parameters.capacity)
+    solution = create_solution(instance, evaluation, [[1], [2], [3], [4], [5]])
+    parameters = evrptw.ParallelALNSParameters()
+    parameters.number_of_workers = number_of_workers
+    parameters.number_of_iterations = 50
+    parameters.period_length = 5
+    large_neighborhood = evrptw.ParallelAdaptiveLargeNeighborhood(randgen, parameters)
+    large_neighborhood.add_destroy_operator(evrptw.operators.RandomRemovalOperator(randgen))
+    large_neighborhood.add_destroy_operator(
+        evrptw.operators.NativeWorstRemovalOperator(instance, evrptw.operators.NativeFirstMoveSelector()))
+    large_neighborhood.add_repair_operator(evrptw.operators.RandomInsertionOperator(randgen))
+    large_neighborhood.add_repair_operator(
+        evrptw.operators.NativeBestInsertionOperator(instance, evrptw.operators.NativeFirstMoveSelector()))
+
+    best_solution = large_neighborhood.optimize(evaluation, solution)
+    assert best_solution.cost <= solution.cost
+    assert sorted(node.vertex_id for route in best_solution for node in route if not node.vertex.is_depot) \
+           == [1, 2, 3, 4, 5]
+    assert len(large_neighborhood.destroy_operator_weights) == 2
+    assert len(large_neighborhood.repair_operator_weights) == 2
+
+
+def test_parallel_large_neighborhood_python_operators(instance, randgen):
+    py_instance, instance = instance
+    evaluation = evrptw.adptw.Evaluation(py_instance.parameters.battery_capacity_time,
+                                         py_instance.parameters.capacity)
+    solution = create_solution(instance, evaluation, [[1, 2, 3, 4, 5]])
+    parameters = evrptw.ParallelALNSParameters()
+    parameters.number_of_workers = 2
+    large_neighborhood = evrptw.ParallelAdaptiveLargeNeighborhood(randgen, parameters)
+    large_neighborhood.add_destroy_operator(MockDestroyOperator(0))
+    large_neighborhood.add_repair_operator(MockRepairOperator(0))
+    # Python operators cannot be copied to several workers
+    with pytest.raises(RuntimeError):
+        large_neighborhood.optimize(evaluation, solution)
+
+
+def test_parallel_large_neighborhood_python_evaluation(instance, mock_evaluation, randgen):
+    _, instance = instance
+    solution = create_solution(instance, mock_evaluation, [[1, 2, 3, 4, 5]])
+    parameters = evrptw.ParallelALNSParameters()
+    parameters.number_of_workers = 2
+    large_neighborhood = evrptw.ParallelAdaptiveLargeNeighborhood(randgen, parameters)
+    large_neighborhood.add_destroy_operator(evrptw.operators.RandomRemovalOperator(randgen))
+    large_neighborhood.add_repair_operator(evrptw.operators.RandomInsertionOperator(randgen))
+    # Labels of Python evaluations must not be copied by several workers
+    with pytest.raises(RuntimeError):
+        large_neighborhood.optimize(mock_evaluation, solution)
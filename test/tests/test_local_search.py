@@ -294,3 +294,109 @@ def test_neighborhood_iterator(random_solution):
 
     actual_moves = set((x.origin_node, x.target_node) for x in routingblocks.iter_neighborhood(solution))
     assert actual_moves == expected_moves
+
+
+def test_local_search_typed_swap_operator(instance, random_solution_factory):
+    py_instance: helpers.Instance = instance[0]
+    instance: routingblocks.Instance = instance[1]
+    evaluation = adptw.Evaluation(py_instance.parameters.battery_capacity_time, py_instance.parameters.capacity)
+    solution = random_solution_factory(instance=instance, evaluation=evaluation)
+    typed_solution = solution.copy()
+
+    local_search = routingblocks.LocalSearch(instance, evaluation, None, routingblocks.BestImprovementPivotingRule())
+    local_search.optimize(solution, [routingblocks.operators.SwapOperator_0_1(instance, None),
+                                     routingblocks.operators.SwapOperator_1_1(instance, None)])
+    local_search.optimize(typed_solution, [adptw.SwapOperator_0_1(instance, None),
+                                           adptw.SwapOperator_1_1(instance, None)])
+
+    assert typed_solution.cost == pytest.approx(solution.cost)
+    assert [[node.vertex_id for node in route] for route in typed_solution] == \
+           [[node.vertex_id for node in route] for route in solution]
+
+
+def test_typed_swap_operator_rejects_other_evaluation(instance, random_solution_factory):
+    py_instance: helpers.Instance = instance[0]
+    instance: routingblocks.Instance = instance[1]
+    evaluation = adptw.Evaluation(py_instance.parameters.battery_capacity_time, py_instance.parameters.capacity)
+    solution = random_solution_factory(instance=instance, evaluation=evaluation)
+
+    local_search = routingblocks.LocalSearch(instance, evaluation, None, routingblocks.BestImprovementPivotingRule())
+    with pytest.raises(RuntimeError):
+        local_search.optimize(solution, [routingblocks.niftw.SwapOperator_0_1(instance, None)])
+
+
+@pytest.mark.parametrize("pivoting_rule_factory", [routingblocks.BestImprovementPivotingRule,
+                                                   routingblocks.FirstImprovementPivotingRule])
+def test_local_search_parallel_matches_sequential(instance, random_solution_factory, pivoting_rule_factory):
+    py_instance: helpers.Instance = instance[0]
+    instance: routingblocks.Instance = instance[1]
+    evaluation = adptw.Evaluation(py_instance.parameters.battery_capacity_time, py_instance.parameters.capacity)
+    solution = random_solution_factory(instance=instance, evaluation=evaluation)
+    parallel_solution = solution.copy()
+
+    operators = [routingblocks.operators.SwapOperator_0_1(instance, None),
+                 routingblocks.operators.InterRouteTwoOptOperator(instance, None)]
+    routingblocks.LocalSearch(instance, evaluation, None, pivoting_rule_factory()).optimize(solution, operators)
+
+    pivoting_rule = pivoting_rule_factory()
+    parallel_local_search = routingblocks.LocalSearch(instance, evaluation, None, pivoting_rule, number_of_threads=4)
+    assert parallel_local_search.number_of_threads == 4
+    parallel_local_search.optimize(parallel_solution, operators)
+
+    assert parallel_solution.cost == pytest.approx(solution.cost)
+    assert [[node.vertex_id for node in route] for route in parallel_solution] == \
+           [[node.vertex_id for node in route] for route in solution]
+
+
+def test_local_search_parallel_rejects_python_evaluation(instance, mock_evaluation):
+    _, instance = instance
+    with pytest.raises(RuntimeError):
+        routingblocks.LocalSearch(instance, mock_evaluation, None, routingblocks.BestImprovementPivotingRule(),
+                                  number_of_threads=2)
+    # A single thread keeps the GIL
+    routingblocks.LocalSearch(instance, mock_evaluation, None, routingblocks.BestImprovementPivotingRule())
+
+
+def test_local_search_granular_neighborhood(instance, random_solution_factory):
+    py_instance: helpers.Instance = instance[0]
+    instance: routingblocks.Instance = instance[1]
+    evaluation = adptw.Evaluation(py_instance.parameters.battery_capacity_time, py_instance.parameters.capacity)
+    solution = random_solution_factory(instance=instance, evaluation=evaluation)
+    local_search = routingblocks.LocalSearch(instance, evaluation, None, routingblocks.FirstImprovementPivotingRule())
+
+    # Including every arc explores the same neighborhood in the same order as no arc set
+    full_arc_set = routingblocks.ArcSet(instance.number_of_vertices)
+    granular_solution = solution.copy()
+    local_search.optimize(solution, [routingblocks.operators.SwapOperator_0_1(instance, None)])
+    local_search.optimize(granular_solution, [routingblocks.operators.SwapOperator_0_1(instance, full_arc_set)])
+    assert [[node.vertex_id for node in route] for route in granular_solution] == \
+           [[node.vertex_id for node in route] for route in solution]
+
+    # An operator without candidate arcs does not find any move
+    empty_arc_set = routingblocks.ArcSet(instance.number_of_vertices)
+    for i in range(instance.number_of_vertices):
+        for j in range(instance.number_of_vertices):
+            empty_arc_set.forbid_arc(i, j)
+    operator = routingblocks.operators.SwapOperator_0_1(instance, empty_arc_set)
+    operator.prepare_search(solution)
+    assert operator.find_next_improving_move(evaluation, solution, None) is None
+
+
+def test_local_search_operator_cache_invalidated_between_runs(instance, random_solution_factory):
+    py_instance: helpers.Instance = instance[0]
+    instance: routingblocks.Instance = instance[1]
+    evaluation = adptw.Evaluation(py_instance.parameters.battery_capacity_time, py_instance.parameters.capacity)
+    local_search = routingblocks.LocalSearch(instance, evaluation, None, routingblocks.BestImprovementPivotingRule())
+    reused_operator = routingblocks.operators.SwapOperator_0_1(instance, None)
+
+    local_search.optimize(random_solution_factory(instance=instance, evaluation=evaluation), [reused_operator])
+
+    # Changing the evaluation must not let the operator reuse stale move evaluations
+    evaluation.overload_penalty_factor = 1000.
+    solution = random_solution_factory(instance=instance, evaluation=evaluation)
+    fresh_solution = solution.copy()
+    local_search.optimize(solution, [reused_operator])
+    local_search.optimize(fresh_solution, [routingblocks.operators.SwapOperator_0_1(instance, None)])
+
+    assert [[node.vertex_id for node in route] for route in solution] == \
+           [[node.vertex_id for node in route] for route in fresh_solution]
@@ -117,3 +117,21 @@ def test_empty_moves(selector):
         selector([])
     with pytest.raises(AssertionError):
         selector(iter([]))
+
+
+@pytest.mark.parametrize("selector,number_of_moves,expected", [
+    (routingblocks.operators.NativeFirstMoveSelector(), 5, 0),
+    (routingblocks.operators.NativeLastMoveSelector(), 5, 4),
+    (routingblocks.operators.NativeNthMoveSelector(3), 5, 2),
+    (routingblocks.operators.NativeNthMoveSelector(10), 5, 4),
+    (routingblocks.operators.NativeBlinkMoveSelector(0., routingblocks.Random(0)), 5, 0),
+    (routingblocks.operators.NativeBlinkMoveSelector(1., routingblocks.Random(0)), 5, 4),
+])
+def test_native_move_selectors(selector, number_of_moves, expected):
+    assert selector.select(number_of_moves) == expected
+
+
+def test_native_random_move_selector():
+    selector = routingblocks.operators.NativeRandomMoveSelector(routingblocks.Random(0))
+    picks = {selector.select(5) for _ in range(100)}
+    assert picks == {0, 1, 2, 3, 4}
@@ -360,3 +360,64 @@ def test_route_insert_vertices(mock_evaluation, sorted_locations: bool, adptw_in
     route.insert_vertices_after(zip(to_insert, insertion_positions))
     assert expected_route == route
     assert_updated(mock_evaluation, instance, route, uid=prev_modification_timestamp)
+
+
+def test_route_update_only_propagates_modified_segment(mock_evaluation, adptw_instance: evrptw.Instance):
+    instance: evrptw.Instance = adptw_instance
+    customers = list(instance.customers)
+    route = evrptw.create_route(mock_evaluation, instance, [x.vertex_id for x in customers])
+    position = len(route) // 2
+
+    mock_evaluation.reset()
+    route.remove_segment(position, position + 1)
+
+    forward_calls = [op for op in mock_evaluation.ops if isinstance(op, MockEvaluation.ForwardEvaluationCall)]
+    backward_calls = [op for op in mock_evaluation.ops if isinstance(op, MockEvaluation.BackwardEvaluationCall)]
+    # Forward labels are only recomputed from the removal position onwards, backward labels only before it
+    assert len(forward_calls) == len(route) - position
+    assert len(backward_calls) == position
+    assert_updated(mock_evaluation, instance, route)
+
+
+def test_route_backward_propagation_uses_arc_to_successor(mock_evaluation):
+    vertices = [evrptw.Vertex(0, "depot", False, True, {}),
+                evrptw.Vertex(1, "customer1", False, False, {}),
+                evrptw.Vertex(2, "customer2", False, False, {})]
+    # Asymmetric arcs: the arc from i to j differs from the arc from j to i
+    arcs = [[evrptw.Arc((i, j)) for j in range(len(vertices))] for i in range(len(vertices))]
+    instance = evrptw.Instance(vertices, arcs, 1)
+
+    evrptw.create_route(mock_evaluation, instance, [1, 2])
+
+    backward_calls = [op for op in mock_evaluation.ops if isinstance(op, MockEvaluation.BackwardEvaluationCall)]
+    assert {(call.vertex.vertex_id, call.succ_vertex.vertex_id) for call in backward_calls} == {(0, 1), (1, 2), (2, 0)}
+    for call in backward_calls:
+        assert call.arc.data == (call.vertex.vertex_id, call.succ_vertex.vertex_id)
+
+
+def test_adptw_typed_route(instance):
+    from routingblocks import adptw
+    py_instance, instance = instance
+    evaluation = adptw.Evaluation(py_instance.parameters.battery_capacity_time, py_instance.parameters.capacity)
+    vertex_ids = [x.vertex_id for x in instance.customers]
+    random.shuffle(vertex_ids)
+    route = evrptw.create_route(evaluation, instance, vertex_ids)
+
+    typed_route = adptw.TypedRoute(evaluation, instance, route)
+    assert typed_route.vertex_ids == [x.vertex_id for x in route]
+    assert typed_route.cost == pytest.approx(route.cost)
+    assert typed_route.to_route() == route
+
+    for position in range(len(route) - 1):
+        assert typed_route.evaluate_insertion(position, vertex_ids[0]) == pytest.approx(
+            evrptw.evaluate_insertion(evaluation, instance, route, position, vertex_ids[0]))
+    for position in range(1, len(route) - 1):
+        assert typed_route.evaluate_removal(position, position + 1) == pytest.approx(
+            evrptw.evaluate_splice(evaluation, instance, route, position - 1, position + 1))
+
+    typed_route.remove_segment(1, 3)
+    typed_route.insert_segment_after(2, vertex_ids[:2])
+    expected_vertex_ids = [vertex_ids[2], vertex_ids[3], vertex_ids[0], vertex_ids[1], *vertex_ids[4:]]
+    expected_route = evrptw.create_route(evaluation, instance, expected_vertex_ids)
+    assert typed_route.to_route() == expected_route
+    assert typed_route.cost == pytest.approx(expected_route.cost)
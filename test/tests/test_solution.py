@@ -356,6 +356,18 @@ def test_vertex_removal(mock_evaluation: evrptw.Evaluation, adptw_instance: evrp
         assert_cost_correct(solution, routes)
 
 
+
+def test_solution_sequential_insertion_keeps_lookup(adptw_instance: evrptw.Instance, mock_evaluation):
+    instance: evrptw.Instance = adptw_instance
+    solution = evrptw.Solution(mock_evaluation, instance, instance.fleet_size)
+    # Insert customers one by one into random positions of random routes
+    for customer in instance.customers:
+        route_index = random.randrange(len(solution))
+        position = random.randrange(len(solution[route_index]) - 1)
+        solution.insert_vertex_after(evrptw.NodeLocation(route_index, position), customer.vertex_id)
+        assert_positions_correct(solution)
+        assert_cost_correct(solution)
+
 @pytest.mark.parametrize("sort_positions", [True, False])
 def test_solution_remove_vertices(sort_positions: bool, random_solution_factory, adptw_instance: evrptw.Instance,
                                   mock_evaluation: evrptw.Evaluation):